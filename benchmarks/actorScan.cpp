@@ -0,0 +1,152 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+/// @file actorScan.cpp Compares scanning hot Actor fields stored in Actor objects and in ActorTable columns
+
+#include "benchmark.hpp"
+
+#include "core/World.hpp"
+#include "core/Actor.hpp"
+
+#include "util/random.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+	const sf::Vector3i shape{100, 100, 10};
+	const int nActors = 10000;
+	const int repeats = 1000;
+
+	/// Controller before ActorTable cached isOnPlayerSide
+	class LegacyController {
+	public:
+		virtual ~LegacyController() = default;
+
+		[[nodiscard]] virtual bool isOnPlayerSide() const noexcept {
+			return false;
+		}
+	};
+
+	/// @brief Actor fields laid out like before ActorTable
+	/// @details Hot fields are scattered in a large object owned by shared_ptr, player side is asked from Controller
+	struct LegacyActor {
+		core::Actor::Stats stats;
+		std::string id;
+
+		std::unique_ptr<LegacyController> controller;
+		std::vector<std::unique_ptr<int>> effects;
+		std::vector<std::shared_ptr<int>> spells;
+		std::vector<std::unique_ptr<int>> items;
+		std::shared_ptr<int> castedSpell;
+		std::array<std::vector<std::unique_ptr<int>>, util::nEnumerators<EquipmentSlot>> equipment;
+
+		double nextTurn = 0;
+		sf::Vector3i position;
+		double hp;
+		double hpMul = 1;
+
+		double mana = 0;
+		double manaMul = 1;
+
+		std::shared_ptr<core::World> world;
+		std::shared_ptr<core::XpManager> xpManager;
+		std::shared_ptr<render::ParticleManager> particles;
+		util::RandomEngine* randomEngine;
+	};
+
+	/// Same actors as in world laid out like before ActorTable
+	std::vector<std::shared_ptr<LegacyActor>> makeLegacyActors(const core::World& world) {
+		std::vector<std::shared_ptr<LegacyActor>> actors;
+		for (const auto& actor : world.actors()) {
+			auto legacy = std::make_shared<LegacyActor>();
+			legacy->controller = std::make_unique<LegacyController>();
+			legacy->nextTurn = actor->nextTurn();
+			legacy->position = actor->position();
+			legacy->hp = actor->hp();
+			actors.push_back(std::move(legacy));
+		}
+		return actors;
+	}
+
+	std::shared_ptr<core::World> makeWorld(util::RandomEngine& randomEngine) {
+		auto world = std::make_shared<core::World>(randomEngine);
+		world->tiles().assign(shape, core::Tile::EMPTY);
+		for (int i = 0; i < nActors; ++i) {
+			sf::Vector3i position{std::uniform_int_distribution{0, shape.x - 1}(randomEngine),
+			                      std::uniform_int_distribution{0, shape.y - 1}(randomEngine),
+			                      std::uniform_int_distribution{0, shape.z - 1}(randomEngine)};
+			auto actor = std::make_shared<core::Actor>(core::Actor::Stats{.maxHp = 1}, "test", position, world,
+			                                           nullptr, nullptr, &randomEngine);
+			actor->nextTurn(std::uniform_real_distribution{0.0, 100.0}(randomEngine));
+			world->addActor(std::move(actor));
+		}
+		return world;
+	}
+}
+
+int main() {
+	util::RandomEngine randomEngine;
+	auto world = makeWorld(randomEngine);
+	int level = shape.z / 2;
+
+	auto legacyActors = makeLegacyActors(*world);
+
+	benchmark::measure("alive on level, before ActorTable", repeats, nActors, [&] {
+		int count = 0;
+		for (const auto& actor : legacyActors)
+			if (actor->position.z == level && actor->hp > 0 && !actor->controller->isOnPlayerSide())
+				++count;
+		benchmark::doNotOptimize(count);
+	});
+
+	benchmark::measure("alive on level, Actor objects", repeats, nActors, [&] {
+		int count = 0;
+		for (const core::Actor* actor : world->actorsOnLevel(level))
+			if (actor->isAlive() && !actor->isOnPlayerSide())
+				++count;
+		benchmark::doNotOptimize(count);
+	});
+
+	benchmark::measure("alive on level, ActorTable", repeats, nActors, [&] {
+		const auto& table = world->actorTable();
+		auto hps = table.hps();
+		auto isOnPlayerSide = table.isOnPlayerSide();
+
+		int count = 0;
+		for (int i : table.slotsOnLevel(level))
+			count += hps[i] > 0 && !isOnPlayerSide[i];
+		benchmark::doNotOptimize(count);
+	});
+
+	benchmark::measure("min nextTurn, before ActorTable", repeats, nActors, [&] {
+		double minNextTurn = std::numeric_limits<double>::infinity();
+		for (const auto& actor : legacyActors)
+			minNextTurn = std::min(minNextTurn, actor->nextTurn);
+		benchmark::doNotOptimize(minNextTurn);
+	});
+
+	benchmark::measure("min nextTurn, Actor objects", repeats, nActors, [&] {
+		double minNextTurn = std::numeric_limits<double>::infinity();
+		for (const auto& actor : world->actors())
+			minNextTurn = std::min(minNextTurn, actor->nextTurn());
+		benchmark::doNotOptimize(minNextTurn);
+	});
+}
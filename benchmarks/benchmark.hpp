@@ -0,0 +1,56 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#ifndef BENCHMARK_HPP_
+#define BENCHMARK_HPP_
+
+/// @file benchmark.hpp Minimal timing helpers shared by benchmarks
+
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <string_view>
+
+namespace benchmark {
+	/// Prevents compiler from optimizing away computation of value
+	template <typename T>
+	void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static const T* volatile sink;
+		sink = &value;
+#endif
+	}
+
+	/// @brief Runs f repeats times and prints time per item
+	/// @param items Amount of items processed by single f call
+	/// @returns nanoseconds per item
+	template <typename F>
+	double measure(std::string_view name, int repeats, long long items, F&& f) {
+		f();
+
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < repeats; ++i)
+			f();
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+		double perItem = elapsed.count() / (static_cast<double>(repeats) * items);
+		std::cout << std::format("{:<32} {:>10.3f} ns/item {:>12.0f} items/s\n", name, perItem, 1e9 / perItem);
+		return perItem;
+	}
+}
+
+#endif
\ No newline at end of file
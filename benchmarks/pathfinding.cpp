@@ -0,0 +1,150 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+/// @file pathfinding.cpp Compares path search algorithms and frontiers on generated dungeons
+
+#include "benchmark.hpp"
+
+#include "core/World.hpp"
+
+#include "generation/DungeonGenerator.hpp"
+
+#include "util/pathfinding.hpp"
+#include "util/random.hpp"
+
+#include <format>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+	const int nQueries = 200;
+	const int repeats = 20;
+
+	struct Query {
+		sf::Vector3i from;
+		sf::Vector3i to;
+	};
+
+	std::shared_ptr<core::World> generateWorld(sf::Vector3i shape, util::RandomEngine& randomEngine) {
+		auto world = std::make_shared<core::World>(randomEngine);
+		world->tiles().assign(shape, core::Tile::WALL);
+
+		generation::DungeonGenerator dungeonGenerator{world, randomEngine};
+		dungeonGenerator.splitChance(0.8);
+		dungeonGenerator.minSize(2);
+		dungeonGenerator();
+		world->tilesChanged();
+		world->generateStairs();
+		return world;
+	}
+
+	std::vector<Query> makeQueries(core::World& world, bool sameLevel, util::RandomEngine& randomEngine) {
+		std::uniform_int_distribution levelDistribution{0, world.tiles().shape().z - 1};
+		std::vector<Query> queries;
+		while (std::ssize(queries) < nQueries) {
+			int fromLevel = levelDistribution(randomEngine);
+			int toLevel = sameLevel ? fromLevel : levelDistribution(randomEngine);
+			auto from = world.randomFreePosition(fromLevel);
+			auto to = world.randomFreePosition(toLevel);
+			if (from && to)
+				queries.push_back({*from, *to});
+		}
+		return queries;
+	}
+
+	template <typename Frontier, bool jumpPoints = false>
+	void measurePaths(std::string_view name, const core::World& world, const std::vector<Query>& queries) {
+		auto isPassable = [](const core::World& world, sf::Vector3i pos) {
+			return core::isPassable(world.tiles()[pos]);
+		};
+
+		util::PathBuffer buffer;
+		benchmark::measure(name, repeats, std::ssize(queries), [&] {
+			int reached = 0;
+			for (Query query : queries) {
+				if constexpr (jumpPoints)
+					util::findJumpPointPath<Frontier>(world, query.from, query.to, buffer, isPassable);
+				else
+					util::findPath<Frontier>(world, query.from, query.to, buffer, isPassable);
+				reached += buffer[query.to].distance != util::PathBuffer::Node::unreached;
+			}
+			benchmark::doNotOptimize(reached);
+		});
+	}
+
+	template <typename Frontier>
+	void measureExplore(std::string_view name, const core::World& world, const std::vector<Query>& queries) {
+		util::PathBuffer buffer;
+		benchmark::measure(name, repeats, std::ssize(queries), [&] {
+			int found = 0;
+			for (Query query : queries)
+				found += util::findExplorePath<Frontier>(world, query.from, buffer, 
+					[to = query.to](const core::World&, sf::Vector3i pos) {
+						return pos == to;
+					}).has_value();
+			benchmark::doNotOptimize(found);
+		});
+	}
+
+	/// First step of every query; StairGraph stays warm between repeats like between turns
+	void measureHierarchical(std::string_view name, const core::World& world, const std::vector<Query>& queries) {
+		util::Pathfinder pathfinder;
+		benchmark::measure(name, repeats, std::ssize(queries), [&] {
+			int moved = 0;
+			for (Query query : queries) {
+				util::CachedPath path;
+				moved += pathfinder.nextStep(world, query.from, query.to, path) != sf::Vector3i{0, 0, 0};
+			}
+			benchmark::doNotOptimize(moved);
+		});
+	}
+
+	/// Each distinct target costs a single BFS, the rest of the queries only read the field
+	void measureDistanceField(std::string_view name, const core::World& world, const std::vector<Query>& queries) {
+		util::DistanceField field;
+		benchmark::measure(name, repeats, std::ssize(queries), [&] {
+			int reached = 0;
+			field.compute(world, {queries.front().to});
+			for (Query query : queries)
+				reached += field.nextStep(world, query.from) != sf::Vector3i{0, 0, 0};
+			benchmark::doNotOptimize(reached);
+		});
+	}
+
+	void measureDungeon(sf::Vector3i shape, util::RandomEngine& randomEngine) {
+		auto world = generateWorld(shape, randomEngine);
+		auto sameLevel = makeQueries(*world, true, randomEngine);
+		auto anyLevel = makeQueries(*world, false, randomEngine);
+
+		std::cout << std::format("Dungeon {}x{}x{}\n", shape.x, shape.y, shape.z);
+		measurePaths<util::HeapFrontier>("findPath same level, heap", *world, sameLevel);
+		measurePaths<util::BucketFrontier>("findPath same level, buckets", *world, sameLevel);
+		measurePaths<util::BucketFrontier, true>("jump points same level, buckets", *world, sameLevel);
+		measurePaths<util::HeapFrontier>("findPath any level, heap", *world, anyLevel);
+		measurePaths<util::BucketFrontier>("findPath any level, buckets", *world, anyLevel);
+		measurePaths<util::BucketFrontier, true>("jump points any level, buckets", *world, anyLevel);
+		measureHierarchical("stair graph any level", *world, anyLevel);
+		measureExplore<util::HeapFrontier>("findExplorePath, heap", *world, anyLevel);
+		measureExplore<util::BucketFrontier>("findExplorePath, buckets", *world, anyLevel);
+		measureDistanceField("distance field, one target", *world, anyLevel);
+	}
+}
+
+int main() {
+	util::RandomEngine randomEngine;
+	measureDungeon({50, 50, 10}, randomEngine);
+	measureDungeon({100, 100, 20}, randomEngine);
+}
@@ -0,0 +1,161 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+/// @file visibility.cpp Compares per tile ray casting with whole level field of view
+
+#include "benchmark.hpp"
+
+#include "core/World.hpp"
+
+#include "generation/DungeonGenerator.hpp"
+
+#include "util/FieldOfView.hpp"
+#include "util/raycast.hpp"
+#include "util/random.hpp"
+
+#include <format>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace {
+	const int nOrigins = 50;
+	const int nDigs = 5;
+	const int repeats = 5;
+
+	std::shared_ptr<core::World> generateWorld(sf::Vector3i shape, util::RandomEngine& randomEngine) {
+		auto world = std::make_shared<core::World>(randomEngine);
+		world->tiles().assign(shape, core::Tile::WALL);
+
+		generation::DungeonGenerator dungeonGenerator{world, randomEngine};
+		dungeonGenerator.splitChance(0.8);
+		dungeonGenerator.minSize(2);
+		dungeonGenerator();
+		world->tilesChanged();
+		world->generateStairs();
+		return world;
+	}
+
+	std::vector<sf::Vector3i> makeOrigins(core::World& world) {
+		std::vector<sf::Vector3i> origins;
+		while (std::ssize(origins) < nOrigins)
+			if (auto origin = world.randomFreePosition(0))
+				origins.push_back(*origin);
+		return origins;
+	}
+
+	/// First wall to the right of each origin, like ones Dig opens
+	std::vector<sf::Vector3i> makeDigTargets(const core::World& world, const std::vector<sf::Vector3i>& origins) {
+		std::vector<sf::Vector3i> targets;
+		for (sf::Vector3i target : origins) {
+			while (world.tiles().isValidPosition(target) && core::isPassable(world.tiles()[target]))
+				++target.x;
+			if (world.tiles().isValidPosition(target))
+				targets.push_back(target);
+			if (std::ssize(targets) == nDigs)
+				break;
+		}
+		return targets;
+	}
+
+	/// Visibility of the whole origin level like PlayerMap::updateTiles computes it
+	void measureLevel(sf::Vector3i shape, util::RandomEngine& randomEngine) {
+		auto world = generateWorld(shape, randomEngine);
+		auto origins = makeOrigins(*world);
+		long long tiles = static_cast<long long>(shape.x) * shape.y;
+
+		std::cout << std::format("Level {}x{}\n", shape.x, shape.y);
+
+		benchmark::measure("reference rays", repeats, nOrigins * tiles, [&] {
+			int visible = 0;
+			for (sf::Vector3i origin : origins)
+				for (int x = 0; x < shape.x; ++x)
+					for (int y = 0; y < shape.y; ++y)
+						visible += util::castRays(*world, origin, {x, y, origin.z});
+			benchmark::doNotOptimize(visible);
+		});
+
+		util::Raycaster raycaster{world};
+		benchmark::measure("raycaster, cold cache", repeats, nOrigins * tiles, [&] {
+			int visible = 0;
+			for (sf::Vector3i origin : origins) {
+				raycaster.clear();
+				for (int x = 0; x < shape.x; ++x)
+					for (int y = 0; y < shape.y; ++y)
+						visible += raycaster.canSee(origin, {x, y, origin.z});
+			}
+			benchmark::doNotOptimize(visible);
+		});
+
+		raycaster.clear();
+		benchmark::measure("raycaster, warm cache", repeats, nOrigins * tiles, [&] {
+			int visible = 0;
+			for (sf::Vector3i origin : origins)
+				for (int x = 0; x < shape.x; ++x)
+					for (int y = 0; y < shape.y; ++y)
+						visible += raycaster.canSee(origin, {x, y, origin.z});
+			benchmark::doNotOptimize(visible);
+		});
+
+		auto digTargets = makeDigTargets(*world, origins);
+		bool localInvalidation = false;
+		world->addChangeListener([&](const core::ChangeJournal& changes) {
+			if (localInvalidation)
+				raycaster.onChanges(changes);
+			else
+				raycaster.clear();
+		});
+
+		// dig a tile and fill it back, querying from all origins after each change
+		auto measureDigs = [&](std::string_view name) {
+			benchmark::measure(name, 1, 2 * std::ssize(digTargets) * nOrigins * tiles, [&] {
+				int visible = 0;
+				for (sf::Vector3i target : digTargets)
+					for (core::Tile tile : {core::Tile::EMPTY, core::Tile::WALL}) {
+						world->tile(target, tile);
+						world->publishChanges();
+
+						for (sf::Vector3i origin : origins)
+							for (int x = 0; x < shape.x; ++x)
+								for (int y = 0; y < shape.y; ++y)
+									visible += raycaster.canSee(origin, {x, y, origin.z});
+					}
+				benchmark::doNotOptimize(visible);
+			});
+		};
+
+		measureDigs("raycaster, dig and clear");
+		localInvalidation = true;
+		measureDigs("raycaster, dig and invalidate");
+
+		util::FieldOfView fov;
+		benchmark::measure("shadowcasting", repeats, nOrigins * tiles, [&] {
+			int visible = 0;
+			for (sf::Vector3i origin : origins) {
+				fov.compute(*world, origin);
+				for (int x = 0; x < shape.x; ++x)
+					for (int y = 0; y < shape.y; ++y)
+						visible += fov.isVisible({x, y, origin.z});
+			}
+			benchmark::doNotOptimize(visible);
+		});
+	}
+}
+
+int main() {
+	util::RandomEngine randomEngine;
+	measureLevel({50, 50, 1}, randomEngine);
+	measureLevel({100, 100, 1}, randomEngine);
+}
@@ -14,6 +14,7 @@ You should have received a copy of the GNU General Public License along with the
 If not, see <https://www.gnu.org/licenses/>. */
 
 #include "Game.hpp"
+#include "regenerateDungeon.hpp"
 
 #include "render/draw/World.hpp"
 #include "render/draw/DeathScreen.hpp"
@@ -33,6 +34,7 @@ If not, see <https://www.gnu.org/licenses/>. */
 
 #include "util/Keyboard.hpp"
 #include "util/raycast.hpp"
+#include "util/pathfinding.hpp"
 #include "util/filesystem.hpp"
 #include "util/parse.hpp"
 #include "util/parseKeyValue.hpp"
@@ -45,6 +47,7 @@ Game::Game(std::shared_ptr<core::World> newWorld,
            std::unique_ptr<generation::DungeonGenerator> newDungeonGenerator,
            render::Context renderContext_,
            std::shared_ptr<util::Raycaster> raycaster,
+           std::shared_ptr<util::Pathfinder> pathfinder,
            util::LoggerFactory& loggerFactory) :
         world{std::move(newWorld)},
         actorSpawner{std::move(actorSpawner_)}, items{std::move(items_)},
@@ -52,15 +55,26 @@ Game::Game(std::shared_ptr<core::World> newWorld,
         dungeonGenerator_{std::move(newDungeonGenerator)},
         renderContext{std::move(renderContext_)},
         generationLogger{ loggerFactory.create("generation") },
-        saveLogger{loggerFactory.create("save")} {
+        saveLogger{loggerFactory.create("save")},
+        replayLogger{loggerFactory.create("replay")} {
     items->load();
 
     addOnGenerateListener([camera = renderContext.camera]() { camera->reset(); });
     addOnGenerateListener([playerMap = renderContext.playerMap]() { playerMap->onGenerate(); });
     addOnGenerateListener([particles = renderContext.particles]() { particles->clear(); });
-    addOnGenerateListener([raycaster = std::move(raycaster)]() { raycaster->clear(); });
+    addOnGenerateListener([raycaster]() { raycaster->clear(); });
+    addOnGenerateListener([pathfinder]() { pathfinder->clear(); });
     addOnGenerateListener([xpManager = xpManager]() { xpManager->onGenerate(); });
-    addOnGenerateListener([]() { std::filesystem::remove("latest.sav"); });
+
+    world->addChangeListener([raycaster = std::move(raycaster)](const core::ChangeJournal& changes) {
+        raycaster->onChanges(changes);
+    });
+    world->addChangeListener([pathfinder = std::move(pathfinder)](const core::ChangeJournal& changes) {
+        pathfinder->onChanges(changes);
+    });
+    world->addChangeListener([playerMap = renderContext.playerMap](const core::ChangeJournal& changes) {
+        playerMap->onChanges(changes);
+    });
 
     addOnUpdateListener([camera = renderContext.camera](sf::Time elapsedTime) { camera->update(elapsedTime); });
     addOnUpdateListener([playerMap = renderContext.playerMap](sf::Time) { playerMap->update(); });
@@ -68,7 +82,7 @@ Game::Game(std::shared_ptr<core::World> newWorld,
 }
 
 void Game::run() {
-    if (auto v = util::readWhole("latest.sav")) {
+    if (auto v = util::readWhole("latest.sav"); v && usesSave()) {
         loadFromString(*v);
     } else {
         generate();
@@ -77,12 +91,15 @@ void Game::run() {
     sf::Clock clock;
 	while (renderContext.window->isOpen()) {
         sf::Event event;
-        while (renderContext.window->pollEvent(event))
+        while (renderContext.window->pollEvent(event)) {
+            if (recorder_)
+                recorder_->record({event, renderContext.camera->position()});
             handleEvent(event);
-
-        if (world->player().isAlive() && !xpManager->canLevelUp()) {
-            world->update();
         }
+        if (recorder_)
+            recorder_->endFrame();
+
+        updateWorld();
 
         sf::Time elapsedTime = clock.restart();
         onUpdate(elapsedTime);
@@ -90,7 +107,38 @@ void Game::run() {
         draw_();
     }
 
-    save();
+    if (usesSave())
+        save();
+}
+
+void Game::replay(InputReplay& replay) {
+    replaying = true;
+    generate();
+
+    replayLogger->info("Replaying...");
+    sf::Clock clock;
+    int frames = 0;
+    std::vector<RecordedEvent> events;
+    while (renderContext.window->isOpen() && replay.nextFrame(events)) {
+        for (const RecordedEvent& event : events) {
+            if (event.event.type == sf::Event::MouseButtonPressed)
+                renderContext.camera->moveTo(event.cameraPosition);
+            handleEvent(event.event);
+        }
+
+        updateWorld();
+        onUpdate(sf::Time::Zero);
+        ++frames;
+    }
+
+    float elapsedTime = clock.getElapsedTime().asSeconds();
+    replayLogger->info("Replayed {} frames and {} actor turns in {:.3f} s ({:.1f} frames/s)",
+                       frames, world->processedTurns(), elapsedTime, frames / elapsedTime);
+}
+
+void Game::updateWorld() {
+    if (world->player().isAlive() && !xpManager->canLevelUp())
+        world->update();
 }
 
 namespace {
@@ -123,6 +171,7 @@ void Game::loadFromString(std::string_view s) {
         if (key == "Tiles") {
             saveLogger->info("Loading tiles...");
             world->tiles() = util::parseCharMap(data).transform(&core::tileFromChar);
+            world->tilesChanged();
         } else if (key == "Stairs") {
             auto [stairs1, stairs2] = *JutchsON::parse<std::pair<sf::Vector3i, sf::Vector3i>>(data);
             world->addStairs(stairs1, stairs2);
@@ -205,30 +254,15 @@ void Game::handleEvent(sf::Event event) {
         return;
 
     world->player().controller().handleEvent(event);
+    world->publishChanges();
 }
 
 void Game::generate() {
-    generationLogger->info("Started");
-
-    generationLogger->info("Resetting world...");
-    world->clearActors();
-    world->clearItems();
-    items->clearIdentifiedItems();
-    items->randomizeTextures();
-    world->tiles().assign({ 50, 50, 10 }, core::Tile::WALL);
-
-    generationLogger->info("Generating dungeon...");
-    dungeonGenerator()();
-
-    generationLogger->info("Generating stairs...");
-    world->generateStairs();
-
-    actorSpawner->spawn();
-    items->spawn();
-
-    generationLogger->info("Finished");
-
+    regenerateDungeon(*world, *items, dungeonGenerator(), *actorSpawner, *generationLogger);
     onGenerate();
+
+    if (usesSave())
+        std::filesystem::remove("latest.sav");
 }
 
 void Game::draw_() {
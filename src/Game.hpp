@@ -19,9 +19,12 @@ If not, see <https://www.gnu.org/licenses/>. */
 #include "core/fwd.hpp"
 #include "generation/fwd.hpp"
 
+#include "InputLog.hpp"
+
 #include "render/Context.hpp"
 
 #include "util/raycast.hpp"
+#include "util/pathfinding.hpp"
 #include "util/Signal.hpp"
 #include "util/random.hpp"
 #include "util/log.hpp"
@@ -41,6 +44,7 @@ public:
          std::unique_ptr<generation::DungeonGenerator> dungeonGenerator,
          render::Context renderContext,
          std::shared_ptr<util::Raycaster> raycaster,
+         std::shared_ptr<util::Pathfinder> pathfinder,
          util::LoggerFactory& loggerFactory);
 
     [[nodiscard]] generation::DungeonGenerator& dungeonGenerator() noexcept {
@@ -51,9 +55,21 @@ public:
         return *dungeonGenerator_;
     }
 
-    /// Generates world and runs game loop until exit
+    /// @brief Generates world and runs game loop until exit
+    /// @details If recorder is set, always starts a new game so the record can be replayed
+    /// and leaves the saved game untouched
     void run();
 
+    /// @brief Replays recorded input at maximum speed without rendering
+    /// @details Starts a new game and feeds recorded frames to the game logic. Saved game is left untouched.
+    /// Log uses frame boundaries instead of time, so camera is moved to the recorded position before each click
+    void replay(InputReplay& replay);
+
+    /// Records seed and player input while running
+    void recorder(std::unique_ptr<InputRecorder> newRecorder) noexcept {
+        recorder_ = std::move(newRecorder);
+    }
+
     void addOnGenerateListener(auto listener) {
         onGenerate.addListener(std::move(listener));
     }
@@ -71,13 +87,23 @@ private:
 
     render::Context renderContext;
 
+    std::unique_ptr<InputRecorder> recorder_;
+    bool replaying = false;
+
     std::shared_ptr<spdlog::logger> generationLogger;
     std::shared_ptr<spdlog::logger> saveLogger;
+    std::shared_ptr<spdlog::logger> replayLogger;
 
     util::Signal<> onGenerate;
     util::Signal<sf::Time> onUpdate;
 
+    /// Recorded and replayed games are separate from the normal one, so they neither load nor remove nor write latest.sav
+    [[nodiscard]] bool usesSave() const noexcept {
+        return !recorder_ && !replaying;
+    }
+
     void handleEvent(sf::Event event);
+    void updateWorld();
     void generate();
     void draw_();
 
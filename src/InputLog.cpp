@@ -0,0 +1,227 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "InputLog.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string_view>
+
+namespace {
+    constexpr std::string_view magic = "TROTEINP";
+    const std::uint8_t version = 2;
+
+    enum class Tag : std::uint8_t {
+        END_FRAME,
+        CLOSED,
+        KEY_PRESSED,
+        MOUSE_BUTTON_PRESSED
+    };
+
+    const std::uint8_t altBit = 1;
+    const std::uint8_t controlBit = 2;
+    const std::uint8_t shiftBit = 4;
+    const std::uint8_t systemBit = 8;
+
+    /// Writes value as size bytes in little endian order
+    void writeUint(std::ofstream& file, std::uint64_t value, int size) {
+        for (int i = 0; i < size; ++i) {
+            file.put(static_cast<char>(value & 0xFF));
+            value >>= 8;
+        }
+    }
+
+    /// Reads size bytes in little endian order. Returns false if stream ended
+    [[nodiscard]] bool readUint(std::ifstream& file, std::uint64_t& value, int size) {
+        value = 0;
+        for (int i = 0; i < size; ++i) {
+            char c;
+            if (!file.get(c))
+                return false;
+            value |= static_cast<std::uint64_t>(static_cast<unsigned char>(c)) << (8 * i);
+        }
+        return true;
+    }
+
+    /// Writes signed value as size bytes in two's complement
+    void writeInt(std::ofstream& file, std::int64_t value, int size) {
+        writeUint(file, static_cast<std::uint64_t>(value), size);
+    }
+
+    /// Reads signed value from size bytes in two's complement
+    [[nodiscard]] bool readInt(std::ifstream& file, std::int64_t& value, int size) {
+        std::uint64_t raw;
+        if (!readUint(file, raw, size))
+            return false;
+
+        std::uint64_t signBit = std::uint64_t{1} << (8 * size - 1);
+        value = static_cast<std::int64_t>((raw ^ signBit) - signBit);
+        return true;
+    }
+
+    /// Writes float as 4 bytes of its representation so it's read back exactly
+    void writeFloat(std::ofstream& file, float value) {
+        writeUint(file, std::bit_cast<std::uint32_t>(value), 4);
+    }
+
+    [[nodiscard]] bool readFloat(std::ifstream& file, float& value) {
+        std::uint64_t raw;
+        if (!readUint(file, raw, 4))
+            return false;
+
+        value = std::bit_cast<float>(static_cast<std::uint32_t>(raw));
+        return true;
+    }
+}
+
+InputRecorder::InputRecorder(const std::filesystem::path& path, util::SeedT seed, sf::Vector2u windowSize) :
+        file{path, std::ios::binary} {
+    if (!file)
+        throw WriteError{std::format("Unable to open {} for input recording", path.generic_string())};
+
+    file.write(magic.data(), std::ssize(magic));
+    writeUint(file, version, 1);
+    writeUint(file, seed, 8);
+    writeUint(file, windowSize.x, 2);
+    writeUint(file, windowSize.y, 2);
+}
+
+bool InputRecorder::isRecorded(const sf::Event& event) noexcept {
+    return event.type == sf::Event::Closed
+        || event.type == sf::Event::KeyPressed
+        || event.type == sf::Event::MouseButtonPressed;
+}
+
+void InputRecorder::record(const RecordedEvent& recordedEvent) {
+    const sf::Event& event = recordedEvent.event;
+    if (!isRecorded(event))
+        return;
+
+    switch (event.type) {
+    case sf::Event::Closed:
+        writeUint(file, static_cast<std::uint8_t>(Tag::CLOSED), 1);
+        break;
+    case sf::Event::KeyPressed: {
+        std::uint8_t modifiers = (event.key.alt ? altBit : 0) | (event.key.control ? controlBit : 0)
+                               | (event.key.shift ? shiftBit : 0) | (event.key.system ? systemBit : 0);
+        writeUint(file, static_cast<std::uint8_t>(Tag::KEY_PRESSED), 1);
+        writeInt(file, event.key.code, 1);
+        writeUint(file, modifiers, 1);
+        break;
+    }
+    case sf::Event::MouseButtonPressed:
+        writeUint(file, static_cast<std::uint8_t>(Tag::MOUSE_BUTTON_PRESSED), 1);
+        writeUint(file, event.mouseButton.button, 1);
+        writeInt(file, event.mouseButton.x, 2);
+        writeInt(file, event.mouseButton.y, 2);
+        writeFloat(file, recordedEvent.cameraPosition.x);
+        writeFloat(file, recordedEvent.cameraPosition.y);
+        writeInt(file, recordedEvent.cameraPosition.z, 2);
+        break;
+    default:
+        break;
+    }
+    frameHasEvents = true;
+}
+
+void InputRecorder::endFrame() {
+    if (!frameHasEvents)
+        return;
+
+    writeUint(file, static_cast<std::uint8_t>(Tag::END_FRAME), 1);
+    file.flush();
+    if (!file)
+        throw WriteError{"Unable to write input log"};
+    frameHasEvents = false;
+}
+
+InputReplay::InputReplay(const std::filesystem::path& path) : file{path, std::ios::binary} {
+    if (!file)
+        throw ReadError{std::format("Unable to open input log {}", path.generic_string())};
+
+    std::array<char, magic.size()> fileMagic;
+    if (!file.read(fileMagic.data(), std::ssize(fileMagic))
+     || std::string_view{fileMagic.data(), fileMagic.size()} != magic)
+        throw ReadError{std::format("{} isn't an input log", path.generic_string())};
+
+    std::uint64_t fileVersion, seed, width, height;
+    if (!readUint(file, fileVersion, 1) || !readUint(file, seed, 8)
+     || !readUint(file, width, 2) || !readUint(file, height, 2))
+        throw ReadError{"Input log header is truncated"};
+
+    if (fileVersion != version)
+        throw ReadError{std::format("Unsupported input log version {}", fileVersion)};
+
+    seed_ = seed;
+    windowSize_ = {static_cast<unsigned>(width), static_cast<unsigned>(height)};
+}
+
+bool InputReplay::nextFrame(std::vector<RecordedEvent>& events) {
+    events.clear();
+
+    std::uint64_t tag;
+    if (!readUint(file, tag, 1))
+        return false;
+
+    while (static_cast<Tag>(tag) != Tag::END_FRAME) {
+        RecordedEvent recordedEvent{};
+        sf::Event& event = recordedEvent.event;
+        bool complete = true;
+        switch (static_cast<Tag>(tag)) {
+        case Tag::CLOSED:
+            event.type = sf::Event::Closed;
+            break;
+        case Tag::KEY_PRESSED: {
+            std::int64_t code;
+            std::uint64_t modifiers;
+            complete = readInt(file, code, 1) && readUint(file, modifiers, 1);
+
+            event.type = sf::Event::KeyPressed;
+            event.key.code = static_cast<sf::Keyboard::Key>(code);
+            event.key.alt = modifiers & altBit;
+            event.key.control = modifiers & controlBit;
+            event.key.shift = modifiers & shiftBit;
+            event.key.system = modifiers & systemBit;
+            break;
+        }
+        case Tag::MOUSE_BUTTON_PRESSED: {
+            std::uint64_t button;
+            std::int64_t x, y, cameraZ;
+            complete = readUint(file, button, 1) && readInt(file, x, 2) && readInt(file, y, 2)
+                    && readFloat(file, recordedEvent.cameraPosition.x) && readFloat(file, recordedEvent.cameraPosition.y)
+                    && readInt(file, cameraZ, 2);
+
+            event.type = sf::Event::MouseButtonPressed;
+            event.mouseButton.button = static_cast<sf::Mouse::Button>(button);
+            event.mouseButton.x = static_cast<int>(x);
+            event.mouseButton.y = static_cast<int>(y);
+            recordedEvent.cameraPosition.z = static_cast<int>(cameraZ);
+            break;
+        }
+        default:
+            throw ReadError{std::format("Unknown input log record {}", tag)};
+        }
+
+        if (!complete)
+            throw ReadError{"Input log record is truncated"};
+        events.push_back(recordedEvent);
+
+        if (!readUint(file, tag, 1))
+            throw ReadError{"Input log frame is truncated"};
+    }
+
+    return true;
+}
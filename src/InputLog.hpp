@@ -0,0 +1,106 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#ifndef INPUT_LOG_HPP_
+#define INPUT_LOG_HPP_
+
+/// @file InputLog.hpp Binary log of the seed and player input used to reproduce a game
+
+#include "core/Position.hpp"
+
+#include "util/Exception.hpp"
+#include "util/random.hpp"
+
+#include <SFML/Window/Event.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+/// Event consumed by Game with the state needed to handle it the same way
+struct RecordedEvent {
+    sf::Event event;
+
+    /// @brief Camera position when event was handled
+    /// @details Mouse clicks are mapped to tiles through it and free camera moves with time, not only with input.
+    /// Stored only for mouse button events
+    core::Position<float> cameraPosition;
+};
+
+/// @brief Writes seed and player input to the binary log
+/// @details Log starts with a header (magic, version, seed, window size).
+/// Then it contains events consumed by Game grouped in frames.
+/// Frames without events (except the first one) aren't written, so replay doesn't reproduce time between inputs.
+/// Camera position is stored with each mouse click instead
+class InputRecorder {
+public:
+    /// Error while writing the log
+    class WriteError : public util::RuntimeError {
+        using util::RuntimeError::RuntimeError;
+    };
+
+    /// @brief Creates the log file and writes its header
+    /// @throws InputRecorder::WriteError
+    InputRecorder(const std::filesystem::path& path, util::SeedT seed, sf::Vector2u windowSize);
+
+    /// Checks if event can affect the game and should be recorded
+    [[nodiscard]] static bool isRecorded(const sf::Event& event) noexcept;
+
+    /// Records event if it can affect the game
+    void record(const RecordedEvent& event);
+
+    /// Ends current frame. Writes nothing if no events were recorded in it
+    void endFrame();
+private:
+    std::ofstream file;
+
+    // First frame is always written because its update runs before any input is accepted
+    bool frameHasEvents = true;
+};
+
+/// Reads log written by InputRecorder
+class InputReplay {
+public:
+    /// Error while reading the log
+    class ReadError : public util::RuntimeError {
+        using util::RuntimeError::RuntimeError;
+    };
+
+    /// @brief Opens the log and reads its header
+    /// @throws InputReplay::ReadError
+    InputReplay(const std::filesystem::path& path);
+
+    /// Seed of the recorded game
+    [[nodiscard]] util::SeedT seed() const noexcept {
+        return seed_;
+    }
+
+    /// Size of the window the game was recorded in. Needed to map mouse clicks to the same tiles
+    [[nodiscard]] sf::Vector2u windowSize() const noexcept {
+        return windowSize_;
+    }
+
+    /// @brief Reads events of the next recorded frame into events
+    /// @returns false if log ended
+    /// @throws InputReplay::ReadError if log is truncated or corrupted
+    bool nextFrame(std::vector<RecordedEvent>& events);
+private:
+    std::ifstream file;
+    util::SeedT seed_;
+    sf::Vector2u windowSize_;
+};
+
+#endif
\ No newline at end of file
@@ -23,10 +23,20 @@ namespace core {
 		         std::shared_ptr<World> newWorld, std::shared_ptr<XpManager> xpManager_,
 				 std::shared_ptr<render::ParticleManager> particles_,
 		         util::RandomEngine* newRandomEngine) :
-			stats_{newStats}, id_{newId}, position_{newPosition}, hp_{newStats.maxHp}, mana_{newStats.maxMana},
+			stats_{newStats}, id_{newId}, mana_{newStats.maxMana},
 			world_{ std::move(newWorld) }, xpManager{ std::move(xpManager_) },
 			particles{particles_}, randomEngine_ {newRandomEngine} {
 		equipment_[static_cast<int>(EquipmentSlot::RING)].resize(2);
+
+		if (world_) {
+			table_ = &world_->actorTable();
+		} else {
+			ownTable = std::make_unique<ActorTable>();
+			table_ = ownTable.get();
+		}
+		handle_ = table_->add(*this);
+		table_->position(slot(), newPosition);
+		table_->hp(slot()) = newStats.maxHp;
 	}
 
 	Actor::Actor(Stats stats_, std::string newId,
@@ -40,6 +50,12 @@ namespace core {
 				 util::RandomEngine* newRandomEngine) :
 		Actor{{}, {}, std::move(newWorld), std::move(xpManager), std::move(particles_), newRandomEngine} {}
 
+	Actor::Actor() : Actor{nullptr, nullptr, nullptr, nullptr} {}
+
+	Actor::~Actor() {
+		table_->remove(handle_);
+	}
+
 	void Actor::endTurn(std::shared_ptr<Spell> newCastedSpell) noexcept {
 		if (castedSpell_) {
 			if (castedSpell_ == newCastedSpell) {
@@ -52,8 +68,7 @@ namespace core {
 
 		nextTurn_ += turnDelay();
 
-		hp_ += regen() * turnDelay();
-		hp_ = std::min(hp(), maxHp());
+		table_->hp(slot()) = std::min(hp() + regen() * turnDelay(), maxHp());
 
 		mana_ += manaRegen() * turnDelay();
 		mana_ = std::min(mana(), maxMana());
@@ -82,11 +97,11 @@ namespace core {
 		auto other = world().actorAt(newPosition);
 		if (!other) {
 			position(newPosition);
-			world().makeSound({Sound::Type::WALK, controller().isOnPlayerSide(), position()});
+			world().makeSound({Sound::Type::WALK, isOnPlayerSide(), position()});
 			return true;
 		}
 
-		if (other->controller().isOnPlayerSide() != controller().isOnPlayerSide()) {
+		if (other->isOnPlayerSide() != isOnPlayerSide()) {
 			attack(*other);
 			return true;
 		}
@@ -100,7 +115,7 @@ namespace core {
 
 		controller().handleSwap();
 		other->controller().handleSwap();
-		world().makeSound({ Sound::Type::WALK, controller().isOnPlayerSide(), position() });
+		world().makeSound({ Sound::Type::WALK, isOnPlayerSide(), position() });
 		return true;
 	}
 
@@ -114,7 +129,7 @@ namespace core {
 		if (!other)
 			return true;
 
-		if (other->controller().isOnPlayerSide() != controller().isOnPlayerSide())
+		if (other->isOnPlayerSide() != isOnPlayerSide())
 			return true;
 
 		return forceSwap || other->controller().wantsSwap();
@@ -195,7 +210,7 @@ namespace core {
 	void Actor::updateHp() {
 		double newMHpul = reduceStatBoosters(1., std::plus<>{}, &StatBooster::hpBonus);
 
-		hp_ *= newMHpul / hpMul;
+		table_->hp(slot()) *= newMHpul / hpMul;
 		hpMul = newMHpul;
 
 		double newManaMul = reduceStatBoosters(1., std::plus<>{}, &StatBooster::manaBonus);
@@ -208,7 +223,7 @@ namespace core {
 		other.beAttacked(damage(other), stats().accuracy, DamageType::PHYSICAL);
 		for (const auto& effect : effects_)
 			effect->onAttack(other);
-		world().makeSound({Sound::Type::ATTACK, controller().isOnPlayerSide(), position()});
+		world().makeSound({Sound::Type::ATTACK, isOnPlayerSide(), position()});
 	}
 
 	double Actor::recievedDamageMul(DamageType damageType) {
@@ -224,8 +239,11 @@ namespace core {
 		if (!isAlive())
 			return;
 
-		hp_ -= damage * recievedDamageMul(type);
-		if (!isAlive())
+		table_->hp(slot()) -= damage * recievedDamageMul(type);
+		if (!isAlive()) {
 			xpManager->addXp(stats().xp);
+			if (world_)
+				world_->actorDied(*this);
+		}
 	}
 }
@@ -65,7 +65,7 @@ namespace core {
 			sf::Time projectileFlightTime;
 		};
 
-		Actor() = default;
+		Actor();
 		Actor(Stats stats, std::string id, sf::Vector3i position, 
 			  std::shared_ptr<World> world, std::shared_ptr<XpManager> xpManager, 
 			  std::shared_ptr<render::ParticleManager> particles,
@@ -78,6 +78,23 @@ namespace core {
 			  std::shared_ptr<render::ParticleManager> particles,
 			  util::RandomEngine* randomEngine);
 
+		/// Unregisters from World::actorTable
+		~Actor();
+
+		Actor(const Actor&) = delete;
+		Actor& operator= (const Actor&) = delete;
+
+		/// @brief Weak reference to this Actor
+		/// @details Actors created without World are registered in their own ActorTable
+		[[nodiscard]] ActorHandle handle() const noexcept {
+			return handle_;
+		}
+
+		/// Weak reference to this Actor bound to its ActorTable
+		[[nodiscard]] ActorRef ref() const noexcept {
+			return {*table_, handle_};
+		}
+
 		const Stats& stats() const {
 			return stats_;
 		}
@@ -104,14 +121,24 @@ namespace core {
 
 		void controller(std::unique_ptr<Controller> newController) {
 			controller_ = std::move(newController);
+			table_->isOnPlayerSide(slot()) = controller_ && controller_->isOnPlayerSide();
+		}
+
+		/// @brief Checks if Actor is player ally
+		/// @details Cached from Controller::isOnPlayerSide when controller is set
+		[[nodiscard]] bool isOnPlayerSide() const noexcept {
+			return table_->isOnPlayerSide()[slot()];
 		}
 
 		[[nodiscard]] sf::Vector3i position() const noexcept {
-			return position_;
+			return table_->positions()[slot()];
 		}
 
-		void position(sf::Vector3i newPosition) noexcept {
-			position_ = newPosition;
+		void position(sf::Vector3i newPosition) {
+			sf::Vector3i oldPosition = position();
+			table_->position(slot(), newPosition);
+			if (world_)
+				world_->actorMoved(*this, oldPosition);
 		}
 
 		[[nodiscard]] double nextTurn() const noexcept {
@@ -120,6 +147,8 @@ namespace core {
 
 		void nextTurn(double newNextTurn) noexcept {
 			nextTurn_ = newNextTurn;
+			if (world_)
+				world_->actorRescheduled(*this);
 		}
 
 		[[nodiscard]] bool isAlive() const {
@@ -129,7 +158,9 @@ namespace core {
 		void beDamaged(double damage, DamageType type);
 
 		void beBanished() {
-			hp_ = 0.0;
+			table_->hp(slot()) = 0.0;
+			if (world_)
+				world_->actorDied(*this);
 		}
 
 		/// @brief Attacks this actor with given damage and accuracy
@@ -145,22 +176,24 @@ namespace core {
 
 		/// Gets Actor HP
 		[[nodiscard]] double hp() const noexcept {
-			return hp_;
+			return table_->hps()[slot()];
 		}
 
 		/// Sets Actor HP
 		void hp(double newHp) noexcept {
-			hp_ = newHp;
+			table_->hp(slot()) = newHp;
+			if (!isAlive() && world_)
+				world_->actorDied(*this);
 		}
 
 		/// Gets Actor HP without hpMul
 		[[nodiscard]] double hpUnscaled() const noexcept {
-			return hp_ / hpMul;
+			return hp() / hpMul;
 		}
 
 		/// Sets Actor HP without hpMul
 		void hpUnscaled(double newHp) noexcept {
-			hp_ = newHp * hpMul;
+			table_->hp(slot()) = newHp * hpMul;
 		}
 
 		/// Gets max possible HP
@@ -277,7 +310,7 @@ namespace core {
 		}
 
 		void addEffect(std::unique_ptr<Effect> effect) {
-			effect->owner(weak_from_this());
+			effect->owner(ref());
 			effects_.push_back(std::move(effect));
 			updateHp();
 		}
@@ -293,7 +326,7 @@ namespace core {
 		}
 
 		void addSpell(std::shared_ptr<Spell> spell) {
-			spell->owner(weak_from_this());
+			spell->owner(ref());
 			spells_.push_back(std::move(spell));
 		}
 
@@ -302,7 +335,7 @@ namespace core {
 		}
 
 		void addItem(std::unique_ptr<Item> item) {
-			item->owner(weak_from_this());
+			item->owner(ref());
 			items_.push_back(std::move(item));
 		}
 
@@ -334,8 +367,7 @@ namespace core {
 		}
 
 		void heal(double healed) {
-			hp_ += healed;
-			hp_ = std::min(hp(), maxHp());
+			table_->hp(slot()) = std::min(hp() + healed, maxHp());
 		}
 
 		std::shared_ptr<Spell> castedSpell() const {
@@ -417,18 +449,26 @@ namespace core {
 		std::array<std::vector<std::unique_ptr<Equipment>>, util::nEnumerators<EquipmentSlot>> equipment_;
 
 		double nextTurn_ = 0;
-		sf::Vector3i position_;
-		double hp_;
 		double hpMul = 1;
 
 		double mana_;
 		double manaMul = 1;
 
 		std::shared_ptr<World> world_;
+
+		/// Storage of position, hp and isOnPlayerSide. World::actorTable or ownTable
+		ActorTable* table_ = nullptr;
+		std::unique_ptr<ActorTable> ownTable;
+		ActorHandle handle_;
 		std::shared_ptr<XpManager> xpManager;
 		std::shared_ptr<render::ParticleManager> particles;
 		util::RandomEngine* randomEngine_;
 
+		/// Index of this Actor in table_
+		[[nodiscard]] int slot() const noexcept {
+			return handle_.index();
+		}
+
 		double regen();
 		double manaRegen();
 		double damage(const Actor& target);
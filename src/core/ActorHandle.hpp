@@ -0,0 +1,245 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#ifndef ACTOR_HANDLE_HPP_
+#define ACTOR_HANDLE_HPP_
+
+#include "fwd.hpp"
+
+#include "util/assert.hpp"
+
+#include <SFML/System/Vector3.hpp>
+
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace core {
+	class ActorTable;
+
+	/// @brief Weak reference to Actor registered in ActorTable
+	/// @details Index and generation of the slot. Becomes expired when Actor is destroyed.
+	/// Holds no pointers, so it can be saved as two integers and compared between runs.
+	/// Resolved through the table at the call site with ActorTable::get
+	class ActorHandle {
+	public:
+		/// Null handle. Always expired
+		ActorHandle() = default;
+
+		ActorHandle(int index_, uint32_t generation_) noexcept :
+			index_{index_}, generation_{generation_} {}
+
+		/// Slot index. Unique among Actors alive at the same time
+		[[nodiscard]] int index() const noexcept {
+			return index_;
+		}
+
+		[[nodiscard]] uint32_t generation() const noexcept {
+			return generation_;
+		}
+
+		[[nodiscard]] bool operator== (const ActorHandle&) const noexcept = default;
+	private:
+		int index_ = -1;
+		uint32_t generation_ = 0;
+	};
+
+	/// @brief ActorHandle bound to its ActorTable
+	/// @details Dereferenced like a pointer. Cheaper than std::weak_ptr::lock because no refcounting is involved.
+	/// Stores table address, so it's only for references kept in memory. Save handle() instead
+	class ActorRef {
+	public:
+		/// Null reference. Always expired
+		ActorRef() = default;
+
+		ActorRef(const ActorTable& table_, ActorHandle handle_) noexcept :
+			table{&table_}, handle_{handle_} {}
+
+		/// @brief Referenced Actor
+		/// @warning May return nullptr
+		[[nodiscard]] Actor* get() const noexcept;
+
+		[[nodiscard]] bool expired() const noexcept {
+			return !get();
+		}
+
+		[[nodiscard]] explicit operator bool() const noexcept {
+			return !expired();
+		}
+
+		Actor* operator-> () const {
+			Actor* actor = get();
+			TROTE_ASSERT(actor, "Dereferencing expired ActorRef");
+			return actor;
+		}
+
+		Actor& operator* () const {
+			return *operator->();
+		}
+
+		[[nodiscard]] ActorHandle handle() const noexcept {
+			return handle_;
+		}
+
+		[[nodiscard]] bool operator== (const ActorRef&) const noexcept = default;
+	private:
+		const ActorTable* table = nullptr;
+		ActorHandle handle_;
+	};
+
+	/// @brief Slots of Actors referenced by ActorHandles
+	/// @details Actors register themselves on construction and unregister on destruction.
+	/// Freed slots are reused with incremented generation so old handles become expired.
+	/// Also stores hot Actor fields by column and slots of each level, so scans over Actors on a level are contiguous
+	class ActorTable {
+	public:
+		[[nodiscard]] ActorHandle add(Actor& actor) {
+			int index;
+			if (freeSlots.empty()) {
+				index = size();
+				actors_.emplace_back();
+				generations.emplace_back();
+				positions_.emplace_back();
+				hps_.emplace_back();
+				isOnPlayerSide_.emplace_back();
+				levelSlotIndices.emplace_back(-1);
+			} else {
+				index = freeSlots.back();
+				freeSlots.pop_back();
+			}
+
+			actors_[index] = &actor;
+			positions_[index] = {};
+			hps_[index] = 0;
+			isOnPlayerSide_[index] = false;
+			linkLevel(index);
+			return {index, generations[index]};
+		}
+
+		void remove(ActorHandle handle) {
+			TROTE_ASSERT(get(handle), "Removing expired ActorHandle");
+			unlinkLevel(handle.index());
+			actors_[handle.index()] = nullptr;
+			hps_[handle.index()] = 0;
+			++generations[handle.index()];
+			freeSlots.push_back(handle.index());
+		}
+
+		/// @brief Actor referenced by handle
+		/// @warning May return nullptr
+		[[nodiscard]] Actor* get(ActorHandle handle) const noexcept {
+			int index = handle.index();
+			if (index < 0 || index >= size() || generations[index] != handle.generation())
+				return nullptr;
+			return actors_[index];
+		}
+
+		/// Amount of slots including free ones
+		[[nodiscard]] int size() const noexcept {
+			return static_cast<int>(actors_.size());
+		}
+
+		/// @brief Actor in each slot
+		/// @details nullptr for free slots
+		[[nodiscard]] std::span<Actor* const> actors() const noexcept {
+			return actors_;
+		}
+
+		[[nodiscard]] std::span<const sf::Vector3i> positions() const noexcept {
+			return positions_;
+		}
+
+		/// @brief Hp of Actor in each slot
+		/// @details 0 for free slots so they are never alive
+		[[nodiscard]] std::span<const double> hps() const noexcept {
+			return hps_;
+		}
+
+		/// @brief Nonzero if Actor in slot is player ally
+		/// @details char instead of bool because std::vector<bool> can't be viewed as span
+		[[nodiscard]] std::span<const char> isOnPlayerSide() const noexcept {
+			return isOnPlayerSide_;
+		}
+
+		/// @brief Slots of Actors on given level
+		/// @details Includes dead Actors that aren't destroyed yet. Order is unspecified
+		[[nodiscard]] std::span<const int> slotsOnLevel(int z) const noexcept {
+			if (z < 0 || z >= std::ssize(levelSlots))
+				return {};
+			return levelSlots[z];
+		}
+
+		/// Moves Actor in slot to newPosition keeping slotsOnLevel up to date
+		void position(int index, sf::Vector3i newPosition) {
+			if (positions_[index].z == newPosition.z) {
+				positions_[index] = newPosition;
+				return;
+			}
+
+			unlinkLevel(index);
+			positions_[index] = newPosition;
+			linkLevel(index);
+		}
+
+		[[nodiscard]] double& hp(int index) noexcept {
+			return hps_[index];
+		}
+
+		[[nodiscard]] char& isOnPlayerSide(int index) noexcept {
+			return isOnPlayerSide_[index];
+		}
+	private:
+		std::vector<Actor*> actors_;
+		std::vector<uint32_t> generations;
+		std::vector<int> freeSlots;
+
+		std::vector<sf::Vector3i> positions_;
+		std::vector<double> hps_;
+		std::vector<char> isOnPlayerSide_;
+
+		std::vector<std::vector<int>> levelSlots;
+		/// Index of each slot in levelSlots of its level. -1 for free slots and Actors with negative level
+		std::vector<int> levelSlotIndices;
+
+		void linkLevel(int index) {
+			int z = positions_[index].z;
+			if (z < 0)
+				return;
+
+			if (z >= std::ssize(levelSlots))
+				levelSlots.resize(z + 1);
+			levelSlotIndices[index] = static_cast<int>(levelSlots[z].size());
+			levelSlots[z].push_back(index);
+		}
+
+		void unlinkLevel(int index) {
+			int levelIndex = std::exchange(levelSlotIndices[index], -1);
+			if (levelIndex < 0)
+				return;
+
+			std::vector<int>& slots = levelSlots[positions_[index].z];
+			levelSlotIndices[slots.back()] = levelIndex;
+			slots[levelIndex] = slots.back();
+			slots.pop_back();
+		}
+	};
+
+	inline Actor* ActorRef::get() const noexcept {
+		return table ? table->get(handle_) : nullptr;
+	}
+}
+
+#endif
\ No newline at end of file
@@ -157,12 +157,13 @@ namespace core {
         std::shared_ptr<ItemManager> itemManager_,
         render::Context renderContext_, util::LoggerFactory& loggerFactory,
         util::RandomEngine& randomEngine_,
-        std::shared_ptr<util::Raycaster> raycaster_) :
+        std::shared_ptr<util::Raycaster> raycaster_,
+        std::shared_ptr<util::Pathfinder> pathfinder_) :
             world{std::move(world_)}, xpManager{std::move(xpManager_)},
             effectManager{std::move(effectManager_)}, spellManager{std::move(spellManager_)}, 
             itemManager{std::move(itemManager_)},
             renderContext{std::move(renderContext_)},
-            raycaster{std::move(raycaster_)},
+            raycaster{std::move(raycaster_)}, pathfinder{std::move(pathfinder_)},
             randomEngine{&randomEngine_}, logger{loggerFactory.create("actors")} {
         logger->info("Loading...");
 
@@ -193,10 +194,10 @@ namespace core {
         auto [type, data] = util::parseKeyValuePair(s);
 
         if (type == "player") {
-            return std::make_unique<PlayerController>(actor, raycaster, renderContext);
+            return std::make_unique<PlayerController>(actor, pathfinder, renderContext);
         } else if (type == "enemy") {
             if (data.empty()) {
-                return std::make_unique<EnemyAi>(actor, raycaster);
+                return std::make_unique<EnemyAi>(actor->ref(), raycaster, pathfinder);
             }
 
             util::KeyValueVisitor visitor;
@@ -221,7 +222,7 @@ namespace core {
             util::forEackInlineKeyValuePair(data, visitor);
             visitor.validate();
 
-            return std::make_unique<EnemyAi>(state, actor, raycaster);
+            return std::make_unique<EnemyAi>(state, actor->ref(), raycaster, pathfinder);
         } else {
             throw UnknownControllerError{type};
         }
@@ -234,7 +235,7 @@ namespace core {
                 if (data.minLevel <= level && (!data.maxLevel || level <= data.maxLevel)) {
                     int count = std::uniform_int_distribution{data.minOnLevel, data.maxOnLevel}(*randomEngine);
                     for (int i = 0; i < count; ++i)
-                        if (auto position = world->randomPositionAt(level, 1000, &World::isFree)) {
+                        if (auto position = world->randomFreePosition(level)) {
                             auto enemy = std::make_shared<Actor>(data.stats, id, *position, world, xpManager,
                                 renderContext.particles, randomEngine);
                             enemy->controller(createController(enemy, data.controller));
@@ -427,7 +428,7 @@ namespace core {
                     auto newSpell = spell->clone();
                     newSpell->parseData(data);
                     actor->castedSpell(newSpell);
-                    newSpell->owner(actor);
+                    newSpell->owner(actor->ref());
                     newSpell->restartCast();
                 } else {
                     throw SpellNotFound{id};
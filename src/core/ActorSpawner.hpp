@@ -55,7 +55,8 @@ namespace core {
 					 std::shared_ptr<ItemManager> itemManager_,
 			         render::Context renderContext, util::LoggerFactory& loggerFactory,
 			         util::RandomEngine& randomEngine,
-			         std::shared_ptr<util::Raycaster> raycaster);
+			         std::shared_ptr<util::Raycaster> raycaster,
+			         std::shared_ptr<util::Pathfinder> pathfinder);
 
 		void spawn();
 
@@ -71,6 +72,7 @@ namespace core {
 		std::shared_ptr<ItemManager> itemManager;
 		render::Context renderContext;
 		std::shared_ptr<util::Raycaster> raycaster;
+		std::shared_ptr<util::Pathfinder> pathfinder;
 		util::RandomEngine* randomEngine;
 
 		std::shared_ptr<spdlog::logger> logger;
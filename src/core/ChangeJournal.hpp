@@ -0,0 +1,158 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#ifndef CHANGE_JOURNAL_HPP_
+#define CHANGE_JOURNAL_HPP_
+
+#include "Tile.hpp"
+#include "ActorHandle.hpp"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector3.hpp>
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+namespace core {
+	/// @brief Changes made to World since they were last published
+	/// @details Lets subscribers do incremental work instead of full recomputation
+	class ChangeJournal {
+	public:
+		struct TileChange {
+			sf::Vector3i position;
+			Tile oldTile;
+			Tile newTile;
+		};
+
+		struct ActorChange {
+			enum class Type {
+				SPAWNED,
+				MOVED,
+				DIED,
+			};
+
+			Type type;
+			ActorHandle actor;
+			sf::Vector3i oldPosition; ///< Same as newPosition unless MOVED
+			sf::Vector3i newPosition;
+		};
+
+		struct ItemChange {
+			enum class Type {
+				ADDED,
+				REMOVED,
+			};
+
+			Type type;
+			sf::Vector3i position;
+		};
+
+		[[nodiscard]] std::span<const TileChange> tiles() const noexcept {
+			return tiles_;
+		}
+
+		[[nodiscard]] std::span<const ActorChange> actors() const noexcept {
+			return actors_;
+		}
+
+		[[nodiscard]] std::span<const ItemChange> items() const noexcept {
+			return items_;
+		}
+
+		/// @brief Checks if tiles were changed in bulk (e.g. by generation or loading)
+		/// @details Individual changes aren't recorded in this case
+		[[nodiscard]] bool allTilesChanged() const noexcept {
+			return allTilesChanged_;
+		}
+
+		/// Checks if any tile was changed
+		[[nodiscard]] bool tilesChanged() const noexcept {
+			return allTilesChanged() || !tiles().empty();
+		}
+
+		[[nodiscard]] bool empty() const noexcept {
+			return !tilesChanged() && actors().empty() && items().empty();
+		}
+
+		/// @brief Bounding rect of all changes on level
+		/// @details Whole level if allTilesChanged. Rect with zero size if level wasn't changed
+		[[nodiscard]] sf::IntRect dirtyRect(int level) const noexcept {
+			if (level < 0 || level >= std::ssize(dirtyRects))
+				return {};
+			return dirtyRects[level];
+		}
+
+		void addTileChange(sf::Vector3i position, Tile oldTile, Tile newTile) {
+			tiles_.emplace_back(position, oldTile, newTile);
+			markDirty(position);
+		}
+
+		void addActorChange(ActorChange::Type type, ActorHandle actor, sf::Vector3i oldPosition, sf::Vector3i newPosition) {
+			actors_.emplace_back(type, actor, oldPosition, newPosition);
+			markDirty(oldPosition);
+			markDirty(newPosition);
+		}
+
+		void addItemChange(ItemChange::Type type, sf::Vector3i position) {
+			items_.emplace_back(type, position);
+			markDirty(position);
+		}
+
+		/// Marks all levels of World with given shape as changed
+		void markAllTilesChanged(sf::Vector3i shape) {
+			allTilesChanged_ = true;
+			tiles_.clear();
+			dirtyRects.assign(std::max(shape.z, 0), {0, 0, shape.x, shape.y});
+		}
+
+		void clear() noexcept {
+			tiles_.clear();
+			actors_.clear();
+			items_.clear();
+			dirtyRects.clear();
+			allTilesChanged_ = false;
+		}
+	private:
+		std::vector<TileChange> tiles_;
+		std::vector<ActorChange> actors_;
+		std::vector<ItemChange> items_;
+		bool allTilesChanged_ = false;
+
+		std::vector<sf::IntRect> dirtyRects;
+
+		void markDirty(sf::Vector3i position) {
+			if (position.z < 0)
+				return;
+			if (position.z >= std::ssize(dirtyRects))
+				dirtyRects.resize(position.z + 1);
+
+			sf::IntRect& rect = dirtyRects[position.z];
+			if (rect.width <= 0 || rect.height <= 0) {
+				rect = {position.x, position.y, 1, 1};
+				return;
+			}
+
+			int right = std::max(rect.left + rect.width, position.x + 1);
+			int bottom = std::max(rect.top + rect.height, position.y + 1);
+			rect.left = std::min(rect.left, position.x);
+			rect.top = std::min(rect.top, position.y);
+			rect.width = right - rect.left;
+			rect.height = bottom - rect.top;
+		}
+	};
+}
+
+#endif
\ No newline at end of file
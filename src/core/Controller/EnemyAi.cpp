@@ -29,17 +29,19 @@ namespace {
 }
 
 namespace core {
-	EnemyAi::EnemyAi(State state_, std::weak_ptr<Actor> newEnemy,
-		             std::shared_ptr<util::Raycaster> raycaster_) :
+	EnemyAi::EnemyAi(State state_, ActorRef newEnemy,
+		             std::shared_ptr<util::Raycaster> raycaster_,
+		             std::shared_ptr<util::Pathfinder> pathfinder_) :
 		enemy_{ std::move(newEnemy) }, state{state_}, 
-		raycaster{std::move(raycaster_)}, pathBuffer{std::make_unique<util::PathBuffer>()} {}
+		raycaster{std::move(raycaster_)}, pathfinder{std::move(pathfinder_)} {}
 
-	EnemyAi::EnemyAi(std::weak_ptr<Actor> newEnemy, std::shared_ptr<util::Raycaster> raycaster_) :
-		enemy_{std::move(newEnemy)}, state{.targetPosition = enemy_.lock()->position()}, 
-		raycaster{std::move(raycaster_)}, pathBuffer{std::make_unique<util::PathBuffer>()} {}
+	EnemyAi::EnemyAi(ActorRef newEnemy, std::shared_ptr<util::Raycaster> raycaster_,
+		             std::shared_ptr<util::Pathfinder> pathfinder_) :
+		enemy_{std::move(newEnemy)}, state{.targetPosition = enemy_->position()}, 
+		raycaster{std::move(raycaster_)}, pathfinder{std::move(pathfinder_)} {}
 
 	bool EnemyAi::act() {
-		const auto enemy = enemy_.lock();
+		const auto enemy = enemy_.get();
 		if (enemy->hasRangedAttack() && canSeePlayer()) {
 			auto& player = enemy->world().player();
 			if (util::distance(util::getXY(enemy->position()), util::getXY(player.position())) > 4)
@@ -55,7 +57,7 @@ namespace core {
 	}
 
 	void EnemyAi::updateTarget() noexcept {
-		auto enemy = enemy_.lock();
+		auto enemy = enemy_.get();
 		if (canSeePlayer()) {
 			setTarget(enemy->world().player().position(), 1.);
 			return;
@@ -82,29 +84,29 @@ namespace core {
 	}
 
 	sf::Vector3i EnemyAi::randomNearbyTarget() noexcept {
-		auto enemy = enemy_.lock();
+		auto enemy = enemy_.get();
 
 		int minLevel = std::max(enemy->position().z - 1, 0);
 		int maxLevel = std::min(enemy->position().z + 1, enemy->world().tiles().shape().z - 1);
 		int targetLevel = std::uniform_int_distribution{ minLevel, maxLevel }(enemy->randomEngine());
-		return enemy->world().randomPositionAt(targetLevel, &World::isFree);
+		return enemy->world().randomFreePosition(targetLevel).value_or(enemy->position());
 	}
 
 	sf::Vector3i EnemyAi::tryFollowStairs(sf::Vector3i position) noexcept {
-		auto enemy = enemy_.lock();
+		auto enemy = enemy_.get();
 
-		if (auto upDestination = enemy->world().upStairs(position))
-			return *upDestination;
-		else if (auto downDestination = enemy->world().downStairs(position))
-			return *downDestination;
-		return position;
+		return enemy->world().stairsDestination(position).value_or(position);
 	}
 
 	void EnemyAi::travelToTarget() noexcept {
-		auto enemy = enemy_.lock();
+		auto enemy = enemy_.get();
 
 		wantsSwap(true);
-		sf::Vector3i nextStep_ = util::nextStep(enemy->world(), enemy->position(), state.targetPosition, *pathBuffer);
+		sf::Vector3i nextStep_;
+		if (state.targetPosition == enemy->world().player().position())
+			nextStep_ = pathfinder->nextFlowStep(enemy->world(), enemy->position(), state.targetPosition);
+		else
+			nextStep_ = pathfinder->nextStep(enemy->world(), enemy->position(), state.targetPosition, path);
 		if (nextStep_.z == 0)
 			enemy->tryMoveInDirection(util::getXY(nextStep_), false);
 		else
@@ -112,12 +114,12 @@ namespace core {
 	}
 
 	bool EnemyAi::canSeePlayer() const noexcept {
-		auto enemy = enemy_.lock();
+		auto enemy = enemy_.get();
 		return raycaster->canSee(enemy->position(), enemy->world().player().position());
 	}
 
 	void EnemyAi::handleSound(Sound sound) noexcept {
-		auto enemy = enemy_.lock();
+		auto enemy = enemy_.get();
 
 		if (raycaster->canSee(enemy->position(), sound.position))
 			return; // Ignore sounds with known sources
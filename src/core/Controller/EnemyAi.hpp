@@ -44,8 +44,10 @@ namespace core {
 			bool wandering = false;
 		};
 
-		EnemyAi(State state, std::weak_ptr<Actor> enemy, std::shared_ptr<util::Raycaster> raycaster);
-		EnemyAi(std::weak_ptr<Actor> enemy, std::shared_ptr<util::Raycaster> raycaster);
+		EnemyAi(State state, ActorRef enemy, std::shared_ptr<util::Raycaster> raycaster,
+		        std::shared_ptr<util::Pathfinder> pathfinder);
+		EnemyAi(ActorRef enemy, std::shared_ptr<util::Raycaster> raycaster,
+		        std::shared_ptr<util::Pathfinder> pathfinder);
 
 		/// Chases or attacks Player
 		bool act() final;
@@ -63,12 +65,13 @@ namespace core {
 				util::stringifyVector3(state.targetPosition), state.targetPriority, state.checkStairs, state.wandering);
 		}
 	private:
-		std::weak_ptr<Actor> enemy_;
+		ActorRef enemy_;
 
 		State state;
 
 		std::shared_ptr<util::Raycaster> raycaster;
-		std::unique_ptr<util::PathBuffer> pathBuffer;
+		std::shared_ptr<util::Pathfinder> pathfinder;
+		util::CachedPath path;
 
 		bool canSeePlayer() const noexcept;
 
@@ -29,9 +29,9 @@ If not, see <https://www.gnu.org/licenses/>. */
 
 namespace core {
 	PlayerController::PlayerController(std::shared_ptr<Actor> player_, 
-		                               std::shared_ptr<util::Raycaster> raycaster_,
+		                               std::shared_ptr<util::Pathfinder> pathfinder_,
 		                               render::Context renderContext_) :
-			player{player_}, raycaster{std::move(raycaster_)}, pathBuffer{std::make_unique<util::PathBuffer>()},
+			player{player_->ref()}, pathfinder{std::move(pathfinder_)},
 			renderContext{renderContext_}, travelTarget{player_->position()} {
 		wantsSwap(false);
 		isOnPlayerSide(true);
@@ -42,7 +42,7 @@ namespace core {
 	void PlayerController::endTurn(std::shared_ptr<Spell> newCastedSpell) noexcept {
 		state = State::ENDED_TURN;
 		renderContext.playerMap->clearSounds();
-		player.lock()->endTurn(std::move(newCastedSpell));
+		player->endTurn(std::move(newCastedSpell));
 	}
 
 	void PlayerController::handleEvent(sf::Event event) {
@@ -51,7 +51,7 @@ namespace core {
 
 		if (event.type == sf::Event::KeyPressed) {
 			if (event.key.code == sf::Keyboard::Numpad5) {
-				endTurn(player.lock()->castedSpell());
+				endTurn(player->castedSpell());
 			} else if (event.key.code == sf::Keyboard::Comma) {
 				if (event.key.shift) {
 					if (tryAscentStairs())
@@ -71,12 +71,9 @@ namespace core {
 				state = State::EXPLORING;
 				explore();
 			} else if (util::isNumpad(event.key.code)) {
-				for (ptrdiff_t i = 1; i <= 9; ++i)
-					if (sf::Keyboard::isKeyPressed(util::numpad(i))) {
-						if (player.lock()->tryMove(util::directions<int>[i - 1], true))
-							endTurn();
-						return;
-					}
+				if (ptrdiff_t i = util::fromNumpad(event.key.code); i > 0)
+					if (player->tryMove(util::directions<int>[i - 1], true))
+						endTurn();
 			}
 		} else if (event.type == sf::Event::MouseButtonPressed) {
 			if (event.mouseButton.button == sf::Mouse::Left) {
@@ -88,7 +85,7 @@ namespace core {
 	}
 
 	void PlayerController::handleClick(sf::Vector2i clickPos) {
-		auto player_ = player.lock();
+		auto player_ = player.get();
 		if (auto newCurrentSpell = render::clickedSpell(clickPos, *renderContext.window, *player_)) {
 			auto spell = player_->spells()[*newCurrentSpell];
 			switch (spell->cast()) {
@@ -188,9 +185,9 @@ namespace core {
 	}
 
 	bool PlayerController::moveToTarget() {
-		auto player_ = player.lock();
-		sf::Vector3i nextStep_ = util::nextStep(player_->world(), player_->position(),
-				static_cast<sf::Vector3i>(travelTarget), *pathBuffer, 
+		auto player_ = player.get();
+		sf::Vector3i nextStep_ = pathfinder->nextStep(player_->world(), player_->position(),
+				static_cast<sf::Vector3i>(travelTarget), path, 
 				[&playerMap = *renderContext.playerMap](const core::World& world, sf::Vector3i pos) {
 			return isPassable(world.tiles()[pos]) && playerMap.tileState(core::Position<int>{pos}) != render::PlayerMap::TileState::UNSEEN;
 		});
@@ -206,11 +203,8 @@ namespace core {
 	}
 
 	bool PlayerController::explore() {
-		auto player_ = player.lock();
-		if (auto nextStep = util::nextExploreStep(player_->world(), player_->position(), *pathBuffer,
-			[&playerMap = *renderContext.playerMap](const core::World&, sf::Vector3i pos) {
-			return playerMap.tileState(core::Position<int>{pos}) == render::PlayerMap::TileState::UNSEEN;
-		})) {
+		auto player_ = player.get();
+		if (auto nextStep = renderContext.playerMap->nextExploreStep(player_->position())) {
 			if (player_->tryMove(*nextStep, false)) {
 				renderContext.playerMap->update();
 				player_->endTurn();
@@ -225,7 +219,7 @@ namespace core {
 	}
 
 	void PlayerController::startResting() {
-		auto player_ = player.lock();
+		auto player_ = player.get();
 		if (player_->hp() < player_->maxHp() && player_->mana() < player_->maxMana()) {
 			state = State::WAITING_HP_OR_MANA;
 		} else if (player_->hp() < player_->maxHp()) {
@@ -238,7 +232,7 @@ namespace core {
 	}
 
 	bool PlayerController::shouldRest() const {
-		auto player_ = player.lock();
+		auto player_ = player.get();
 		switch (state) {
 		case State::WAITING_HP_OR_MANA:
 			return player_->hp() < player_->maxHp() && player_->mana() < player_->maxMana();
@@ -257,7 +251,7 @@ namespace core {
 		case State::WAITING_HP:
 		case State::WAITING_MANA: {
 			if (shouldRest()) {
-				auto player_ = player.lock();
+				auto player_ = player.get();
 				player_->endTurn(player_->castedSpell());
 				return true;
 			} else {
@@ -291,29 +285,33 @@ namespace core {
 	}
 
 	bool PlayerController::tryAscentStairs() {
-		auto player_ = player.lock();
+		auto player_ = player.get();
 		if (std::optional<sf::Vector3i> newPos = player_->world().upStairs(player_->position()))
 			return player_->tryMoveTo(*newPos, true);
 		return false;
 	}
 
 	bool PlayerController::tryDescentStairs() {
-		auto player_ = player.lock();
+		auto player_ = player.get();
 		if (std::optional<sf::Vector3i> newPos = player_->world().downStairs(player_->position()))
 			return player_->tryMoveTo(*newPos, true);
 		return false;
 	}
 
 	bool PlayerController::canSeeEnemy() const {
-		auto player_ = player.lock();
-		return std::ranges::any_of(player_->world().actors(), [this, &player_](const auto& actor) {
-			return !actor->controller().isOnPlayerSide() 
-				&& raycaster->canSee(player_->position(), actor->position());
-		});
+		auto player_ = player.get();
+		const auto& actors = player_->world().actorTable();
+		auto positions = actors.positions();
+		auto hps = actors.hps();
+		auto isOnPlayerSide = actors.isOnPlayerSide();
+		for (int i : actors.slotsOnLevel(player_->position().z))
+			if (hps[i] > 0 && !isOnPlayerSide[i] && renderContext.playerMap->canSee(core::Position<int>{positions[i]}))
+				return true;
+		return false;
 	}
 
 	bool PlayerController::tryPickup() {
-		auto player_ = player.lock();
+		auto player_ = player.get();
 		if (auto item = player_->world().removeItem(core::Position<int>{player_->position()})) {
 			player_->addItem(std::move(item));
 			return true;
@@ -25,7 +25,6 @@ If not, see <https://www.gnu.org/licenses/>. */
 #include "render/PlayerMap.hpp"
 
 #include "util/geometry.hpp"
-#include "util/raycast.hpp"
 #include "util/pathfinding.hpp"
 
 #include <SFML/Window/Event.hpp>
@@ -37,7 +36,7 @@ namespace core {
 	class PlayerController : public Controller {
 	public:
 		PlayerController(std::shared_ptr<Actor> player,
-			std::shared_ptr<util::Raycaster> raycaster,
+			std::shared_ptr<util::Pathfinder> pathfinder,
 			render::Context renderContext);
 
 		/// Waits for player input
@@ -67,9 +66,9 @@ namespace core {
 			return "player";
 		}
 	private:
-		std::weak_ptr<Actor> player;
-		std::shared_ptr<util::Raycaster> raycaster;
-		std::unique_ptr<util::PathBuffer> pathBuffer;
+		ActorRef player;
+		std::shared_ptr<util::Pathfinder> pathfinder;
+		util::CachedPath path;
 		render::Context renderContext;
 
 		enum class State {
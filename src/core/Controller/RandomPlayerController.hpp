@@ -0,0 +1,73 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#ifndef RANDOM_PLAYER_CONTROLLER_HPP_
+#define RANDOM_PLAYER_CONTROLLER_HPP_
+
+#include "Controller.hpp"
+
+#include "../fwd.hpp"
+#include "../Actor.hpp"
+#include "../World.hpp"
+
+#include "util/Direction.hpp"
+#include "util/random.hpp"
+
+#include <memory>
+
+namespace core {
+	/// @brief Player controller making random moves without any input
+	/// @details Used for headless simulation. Ends exactly one turn per act call
+	/// so each World::update processes single player turn
+	class RandomPlayerController : public Controller {
+	public:
+		RandomPlayerController(std::shared_ptr<Actor> player_, util::RandomEngine& randomEngine_) :
+				player{player_->ref()}, randomEngine{&randomEngine_} {
+			wantsSwap(false);
+			isOnPlayerSide(true);
+			shouldInterruptOnDelete(true);
+			player_->world().player(player_);
+		}
+
+		/// Follows stairs sometimes, otherwise walks or attacks in random direction
+		bool act() final {
+			Actor* player_ = player.get();
+			if (auto destination = player_->world().stairsDestination(player_->position());
+					destination && std::bernoulli_distribution{stairsChance}(*randomEngine)) {
+				player_->tryMoveTo(*destination, true);
+			} else {
+				std::uniform_int_distribution<ptrdiff_t> directionDistribution{0, std::ssize(util::nonzeroDirections<int>) - 1};
+				for (int i = 0; i < maxTries; ++i)
+					if (player_->tryMove(util::nonzeroDirections<int>[directionDistribution(*randomEngine)], false))
+						break;
+			}
+
+			player_->endTurn();
+			return false;
+		}
+
+		[[nodiscard]] std::string stringify() const final {
+			return "randomPlayer";
+		}
+	private:
+		ActorRef player;
+		util::RandomEngine* randomEngine;
+
+		inline const static int maxTries = 8;
+		inline const static double stairsChance = 0.25;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -17,6 +17,7 @@ If not, see <https://www.gnu.org/licenses/>. */
 #define EFFECT_HPP_
 
 #include "core/fwd.hpp"
+#include "core/ActorHandle.hpp"
 #include "core/DamageType.hpp"
 #include "core/StatBooster.hpp"
 
@@ -61,7 +62,7 @@ namespace core {
 		virtual std::unique_ptr<Effect> clone() const = 0;
 
 		/// Sets Actor owning this skill
-		virtual void owner([[maybe_unused]] std::weak_ptr<Actor> newOwner) {}
+		virtual void owner([[maybe_unused]] ActorRef newOwner) {}
 
 		/// Skill icon for level up menu
 		[[nodiscard]] virtual const sf::Texture& icon() const = 0;
@@ -53,7 +53,7 @@ namespace core {
 		}
 
 		bool shouldApply() const final {
-			auto ownerPtr = owner_.lock();
+			auto ownerPtr = owner_.get();
 			return ownerPtr->hp() < 0.5 * ownerPtr->maxHp();
 		}
 
@@ -61,7 +61,7 @@ namespace core {
 			return std::make_unique<LowHpSkill>(*this);
 		}
 
-		void owner(std::weak_ptr<Actor> newOwner) final {
+		void owner(ActorRef newOwner) final {
 			owner_ = std::move(newOwner);
 		}
 
@@ -87,7 +87,7 @@ namespace core {
 	private:
 		Data data;
 		std::string id_;
-		std::weak_ptr<Actor> owner_;
+		ActorRef owner_;
 	};
 
 	BOOST_DESCRIBE_STRUCT(LowHpSkill::Data, (), (boosts, icon, name))
@@ -38,7 +38,7 @@ namespace core {
 		Poison(Data data_, std::string_view newId) : data{data_}, id_{newId} {}
 
 		void update(double time) final {
-			owner_.lock()->beDamaged(time * data.damageOverTime, DamageType::POISON);
+			owner_->beDamaged(time * data.damageOverTime, DamageType::POISON);
 			data.duration -= time;
 		}
 
@@ -50,7 +50,7 @@ namespace core {
 			return std::make_unique<Poison>(*this);
 		}
 
-		void owner(std::weak_ptr<Actor> newOwner) final {
+		void owner(ActorRef newOwner) final {
 			owner_ = std::move(newOwner);
 		}
 
@@ -88,7 +88,7 @@ namespace core {
 		Data data;
 		std::string id_;
 
-		std::weak_ptr<Actor> owner_;
+		ActorRef owner_;
 	};
 
 	BOOST_DESCRIBE_STRUCT(Poison::Data, (), (damageOverTime, duration, icon, name))
@@ -33,7 +33,7 @@ namespace core {
 	}
 
 	UsageResult Equipment::use() {
-		if (self.lock()->equip(*this, stats.slot)) {
+		if (self->equip(*this, stats.slot)) {
 			identify();
 			return UsageResult::SUCCESS;
 		} else {
@@ -73,7 +73,7 @@ namespace core {
 			return std::make_unique<Equipment>(*this);
 		}
 
-		void owner(std::weak_ptr<Actor> actor) final {
+		void owner(ActorRef actor) final {
 			self = actor;
 		}
 
@@ -126,7 +126,7 @@ namespace core {
 		Stats stats;
 		const sf::Texture* texture;
 
-		std::weak_ptr<Actor> self;
+		ActorRef self;
 
 		std::shared_ptr<ItemManager> items;
 		std::shared_ptr<XpManager> xpManager;
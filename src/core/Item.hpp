@@ -17,6 +17,7 @@ If not, see <https://www.gnu.org/licenses/>. */
 #define ITEM_HPP_
 
 #include "fwd.hpp"
+#include "ActorHandle.hpp"
 #include "Position.hpp"
 #include "Usable.hpp"
 
@@ -85,7 +86,7 @@ namespace core {
 
 		[[nodiscard]] virtual std::unique_ptr<Item> clone() const = 0;
 
-		virtual void owner(std::weak_ptr<Actor>) {}
+		virtual void owner(ActorRef) {}
 
 		virtual sf::Color frameColor() const {
 			return sf::Color{128, 128, 128};
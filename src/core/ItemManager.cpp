@@ -176,7 +176,7 @@ namespace core {
 		logger->info("Spawning...");
 		for (int z = 0; z < world->tiles().shape().z; ++z) {
 			for (int i = 0; i < std::uniform_int_distribution{3, 10}(*randomEngine); ++i) {
-				if (auto pos = world->randomPositionAt(z, 1000, &World::isFree)) {
+				if (auto pos = world->randomFreePosition(z)) {
 					switch (std::uniform_int_distribution{0, 2}(*randomEngine)) {
 					case 0: {
 						auto ispell = std::uniform_int_distribution<ptrdiff_t>{0, std::ssize(scrollableSpells) - 1}(*randomEngine);
@@ -61,14 +61,14 @@ namespace core {
 			items{std::move(items_)}, xpManager{std::move(xpManager_)}, assets{std::move(assets_)}, randomEngine{&randomEngine_} {}
 
 		UsageResult use() final {
-			self.lock()->heal(stats.hp);
-			self.lock()->restoreMana(stats.mana);
+			self->heal(stats.hp);
+			self->restoreMana(stats.mana);
 			xpManager->addXp(stats.xp);
 			if (stats.cancelEffects) {
-				self.lock()->cancelEffects();
+				self->cancelEffects();
 			}
 			if (stats.effect) {
-				self.lock()->addEffect(stats.effect->clone());
+				self->addEffect(stats.effect->clone());
 			}
 			
 			identify();
@@ -86,7 +86,7 @@ namespace core {
 			return std::make_unique<Potion>(*this);
 		}
 
-		void owner(std::weak_ptr<Actor> actor) final {
+		void owner(ActorRef actor) final {
 			self = actor;
 		}
 
@@ -98,7 +98,7 @@ namespace core {
 	private:
 		Stats stats;
 
-		std::weak_ptr<Actor> self;
+		ActorRef self;
 		bool shouldDestroy_ = false;
 
 		const sf::Texture* icon_;
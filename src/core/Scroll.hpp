@@ -97,7 +97,7 @@ namespace core {
 			return result;
 		}
 
-		void owner(std::weak_ptr<Actor> actor) final {
+		void owner(ActorRef actor) final {
 			self = actor;
 			spell->owner(std::move(actor));
 		}
@@ -107,7 +107,7 @@ namespace core {
 		}
 	private:
 		std::shared_ptr<Spell> spell;
-		std::weak_ptr<Actor> self;
+		ActorRef self;
 		bool shouldDestroy_ = false;
 
 		std::shared_ptr<ItemManager> items;
@@ -51,14 +51,14 @@ namespace core {
 				return cloned;
 			}
 
-			void owner(std::weak_ptr<Actor> newOwner) {
-				newOwner.lock()->addEffect(bonus->clone());
+			void owner(ActorRef newOwner) {
+				newOwner->addEffect(bonus->clone());
 				owner_ = std::move(newOwner);
 			}
 
 			sf::Color frameColor() const final {
 				if (isOn) {
-					if (owner_.lock()->mana() > mana) {
+					if (owner_->mana() > mana) {
 						return sf::Color::Green;
 					} else {
 						return sf::Color::Red;
@@ -89,7 +89,7 @@ namespace core {
 
 				bool shouldApply() const final {
 					auto spell = spell_.lock();
-					return spell->isOn && owner_.lock()->mana() > spell->mana;
+					return spell->isOn && owner_->mana() > spell->mana;
 				}
 
 				void update(double time) final {
@@ -97,10 +97,10 @@ namespace core {
 					if (!spell->isOn)
 						return;
 
-					owner_.lock()->useMana(time * spell->mana);
+					owner_->useMana(time * spell->mana);
 				}
 
-				void owner(std::weak_ptr<Actor> newOwner) final {
+				void owner(ActorRef newOwner) final {
 					owner_ = std::move(newOwner);
 				}
 
@@ -149,14 +149,14 @@ namespace core {
 				std::string id_;
 				std::string name_;
 				std::weak_ptr<Bonus> spell_;
-				std::weak_ptr<core::Actor> owner_;
+				ActorRef owner_;
 			};
 
 			bool isOn = false;
 			bool useMana = true;
 			double mana;
 			std::shared_ptr<Effect> bonus;
-			std::weak_ptr<core::Actor> owner_;
+			ActorRef owner_;
 		};
 
 		BOOST_DESCRIBE_STRUCT(Bonus::Data, (), (icon, name, boosts, mana))
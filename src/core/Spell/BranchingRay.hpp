@@ -96,7 +96,11 @@ namespace core {
 
 				float distance = util::distance(pos1, pos2);
 
+				// Placeholder textures used without display are empty
 				auto segmentLen = static_cast<float>(data.rayTexture->getSize().y);
+				if (segmentLen <= 0.f)
+					return;
+
 				for (float d = 0; d < distance; d += segmentLen) {
 					sf::Vector2f pos = util::lerp(pos1, pos2, d / distance);
 					particles->add(pos, prev.z, rotation, data.visibleTime, data.rayTexture);
@@ -112,8 +116,8 @@ namespace core {
 				world->makeSound({Sound::Type::ATTACK, true, prev.position()});
 				spawnRay(core::Position<int>{prev.position()}, core::Position<int>{next.position()});
 
-				for (const auto& actor : world->actors())
-					if (actor.get() != &next && actor.get() != &prev && actor->isAlive() && actor->position().z == next.position().z
+				for (Actor* actor : world->actorsOnLevel(next.position().z))
+					if (actor != &next && actor != &prev && actor->isAlive()
 						&& std::bernoulli_distribution{data.chainChance}(*randomEngine))
 						attack(next, *actor);
 				return true;
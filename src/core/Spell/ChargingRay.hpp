@@ -71,8 +71,8 @@ namespace core {
 				if (!target_)
 					return UsageResult::FAILURE;
 
-				if (owner()->castedSpell().get() != this || useMana != useMana_ || target_ != target.lock()) {
-					target = std::move(target_);
+				if (owner()->castedSpell().get() != this || useMana != useMana_ || target_.get() != target.get()) {
+					target = target_->ref();
 					damageMul = 1;
 					particles->add(std::make_unique<Ray>(shared_from_this(), particles));
 				}
@@ -99,7 +99,8 @@ namespace core {
 				});
 
 				visitor.key("targetPosition").unique().callback([&](std::string_view data) {
-					target = world->actorAt(util::parseVector3i(data));
+					if (auto target_ = world->actorAt(util::parseVector3i(data)))
+						target = target_->ref();
 				});
 
 				util::forEackInlineKeyValuePair(data, visitor);
@@ -109,7 +110,7 @@ namespace core {
 			[[nodiscard]] std::string stringify() const final {
 				std::string result = std::format("{} damageMul {}", id(), damageMul);
 				if (!target.expired()) {
-					result += std::format(", targetPosition {}", util::stringifyVector3(target.lock()->position()));
+					result += std::format(", targetPosition {}", util::stringifyVector3(target->position()));
 				}
 				return result;
 			}
@@ -120,7 +121,7 @@ namespace core {
 		private:
 			Data data;
 
-			std::weak_ptr<Actor> target;
+			ActorRef target;
 			double damageMul = 1;
 
 			bool useMana = true;
@@ -135,13 +136,13 @@ namespace core {
 				Ray(std::shared_ptr<ChargingRay> spell_, std::weak_ptr<render::ParticleManager> particleManager_) :
 					spell{std::move(spell_)}, particleManager{std::move(particleManager_)} {
 					if (!spell->target.expired())
-						targetPos = spell->target.lock()->position();
+						targetPos = spell->target->position();
 				}
 
 				void update(sf::Time elapsedTime) final {
 					lifetime += elapsedTime;
 					if (!spell->target.expired())
-						targetPos = spell->target.lock()->position();
+						targetPos = spell->target->position();
 				}
 
 				void draw(sf::RenderTarget& target, core::Position<float> cameraPos) const {
@@ -180,7 +181,7 @@ namespace core {
 					return false;
 				}
 
-				auto target_ = target.lock();
+				auto target_ = target.get();
 
 				return target_->isAlive()
 					&& raycaster->canSee(owner()->position(), target_->position())
@@ -196,7 +197,7 @@ namespace core {
 					return false;
 				}
 
-				auto target_ = target.lock();
+				auto target_ = target.get();
 
 				if (useMana && !owner()->useMana(data.mana)) {
 					return false;
@@ -84,7 +84,7 @@ namespace core {
 
 			using Spell::owner;
 
-			void owner(std::weak_ptr<Actor> newOwner) {
+			void owner(ActorRef newOwner) {
 				Spell::owner(newOwner);
 				owner()->addEffect(bonus->clone());
 			}
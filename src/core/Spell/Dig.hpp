@@ -25,9 +25,10 @@ If not, see <https://www.gnu.org/licenses/>. */
 #include "core/Actor.hpp"
 
 #include "render/ParticleManager.hpp"
-#include "render/PlayerMap.hpp"
 #include "render/coords.hpp"
 
+#include "util/raycast.hpp"
+
 namespace sf {
 	class Texture;
 }
@@ -53,17 +54,15 @@ namespace core {
 
 			Dig(Data data_, const auto& env) :
 				Spell{*data_.icon, env.id, data_.name}, data{data_}, world{env.world},
-				particles{env.particles}, playerMap{env.playerMap}, raycaster{env.raycaster} {}
+				particles{env.particles}, raycaster{env.raycaster} {}
 
 			UsageResult cast(core::Position<int> target, bool useMana = true) final {
-				if (world->tiles()[static_cast<sf::Vector3i>(target)] != Tile::WALL
+				if (world->tile(static_cast<sf::Vector3i>(target)) != Tile::WALL
 					|| !raycaster->canSee(owner()->position(), static_cast<sf::Vector3i>(target))
 					|| useMana && !owner()->useMana(data.mana))
 					return UsageResult::FAILURE;
 
-				world->tiles()[static_cast<sf::Vector3i>(target)] = Tile::EMPTY;
-				raycaster->clear();
-				playerMap->updateTiles();
+				world->tile(static_cast<sf::Vector3i>(target), Tile::EMPTY);
 				spawnParticle(core::Position<int>{owner()->position()}, target);
 
 				return UsageResult::SUCCESS;
@@ -77,7 +76,6 @@ namespace core {
 
 			std::shared_ptr<World> world;
 			std::shared_ptr<render::ParticleManager> particles;
-			std::shared_ptr<render::PlayerMap> playerMap;
 			std::shared_ptr<util::Raycaster> raycaster;
 
 			void spawnParticle(core::Position<int> self, core::Position<int> target) {
@@ -73,9 +73,8 @@ namespace core {
 					return UsageResult::FAILURE;
 				}
 
-				for (const auto& actor : world->actors()) {
-					if (util::distance(util::getXY(actor->position()), target.xy()) <= data.explosionRadius
-						&& raycaster->canSee(static_cast<sf::Vector3i>(target), actor->position())) {
+				for (Actor* actor : world->actorsInRadius(static_cast<sf::Vector3i>(target), data.explosionRadius)) {
+					if (raycaster->canSee(static_cast<sf::Vector3i>(target), actor->position())) {
 						data.impact.apply(*actor);
 						world->makeSound({Sound::Type::ATTACK, true, actor->position()});
 					}
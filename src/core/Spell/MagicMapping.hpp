@@ -24,6 +24,7 @@ If not, see <https://www.gnu.org/licenses/>. */
 #include "core/Actor.hpp"
 
 #include "render/ParticleManager.hpp"
+#include "render/PlayerMap.hpp"
 
 namespace sf {
 	class Texture;
@@ -29,7 +29,7 @@ If not, see <https://www.gnu.org/licenses/>. */
 #include "render/ParticleManager.hpp"
 #include "render/coords.hpp"
 
-#include "util/raycast.hpp"
+#include "util/FieldOfView.hpp"
 #include "util/random.hpp"
 
 namespace sf {
@@ -62,7 +62,7 @@ namespace core {
 
 			Radiance(Data data_, const auto& env) :
 				Spell{*data_.icon, env.id, data_.name}, data{data_}, world{env.world},
-				particles{env.particles}, raycaster{env.raycaster} {}
+				particles{env.particles} {}
 
 			UsageResult cast(bool useMana = true) final {
 				if (useMana && !owner()->useMana(data.mana))
@@ -70,12 +70,15 @@ namespace core {
 
 				world->makeSound({Sound::Type::ATTACK, true, owner()->position()});
 
-				for (const auto& actor : world->actors())
-					if (actor.get() != owner().get() && raycaster->canSee(owner()->position(), actor->position())) {
+				util::FieldOfView fov;
+				fov.compute(*world, owner()->position());
+
+				for (Actor* actor : world->actorsOnLevel(owner()->position().z))
+					if (actor != owner() && fov.isVisible(actor->position())) {
 						data.impact.apply(*actor);
 					}
 
-				spawnAura(core::Position<int>{owner()->position()});
+				spawnAura(core::Position<int>{owner()->position()}, fov);
 
 				return UsageResult::SUCCESS;
 			}
@@ -88,12 +91,11 @@ namespace core {
 
 			std::shared_ptr<World> world;
 			std::shared_ptr<render::ParticleManager> particles;
-			std::shared_ptr<util::Raycaster> raycaster;
 
-			void spawnAura(core::Position<int> self) {
+			void spawnAura(core::Position<int> self, const util::FieldOfView& fov) {
 				for (int x = 0; x < world->tiles().shape().x; ++x)
 					for (int y = 0; y < world->tiles().shape().y; ++y) {
-						if (raycaster->canSee(static_cast<sf::Vector3i>(self), {x, y, self.z})) {
+						if (fov.isVisible({x, y, self.z})) {
 							sf::Vector2f pos = render::toScreen(sf::Vector2f{x + 0.5f, y + 0.5f});
 							particles->add(pos, self.z, data.visibleTime, data.tileTexture);
 						}
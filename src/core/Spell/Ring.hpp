@@ -72,9 +72,8 @@ namespace core {
 					return UsageResult::FAILURE;
 				}
 
-				for (const auto& actor : world->actors()) {
-					if (actor.get() != owner().get()
-						&& util::distance(util::getXY(actor->position()), util::getXY(owner()->position())) <= data.radius
+				for (Actor* actor : world->actorsInRadius(owner()->position(), data.radius)) {
+					if (actor != owner()
 						&& raycaster->canSee(owner()->position(), actor->position())) {
 						data.impact.apply(*actor);
 						world->makeSound({Sound::Type::ATTACK, true, actor->position()});
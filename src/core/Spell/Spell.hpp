@@ -17,6 +17,7 @@ If not, see <https://www.gnu.org/licenses/>. */
 #define SPELL_HPP_
 
 #include "core/fwd.hpp"
+#include "core/ActorHandle.hpp"
 #include "core/DamageType.hpp"
 #include "core/Position.hpp"
 #include "core/Usable.hpp"
@@ -89,7 +90,7 @@ namespace core {
 
 		[[nodiscard]] virtual std::shared_ptr<Spell> clone() const = 0;
 
-		virtual void owner(std::weak_ptr<Actor> newOwner) {
+		virtual void owner(ActorRef newOwner) {
 			owner_ = std::move(newOwner);
 		}
 
@@ -118,15 +119,15 @@ namespace core {
 			return true;
 		}
 	protected:
-		[[nodiscard]] std::shared_ptr<Actor> owner() const {
-			return owner_.lock();
+		[[nodiscard]] Actor* owner() const noexcept {
+			return owner_.get();
 		}
 	private:
 		const sf::Texture* icon_;
 		std::string id_;
 		std::string name_;
 
-		std::weak_ptr<Actor> owner_;
+		ActorRef owner_;
 	};
 }
 
@@ -49,12 +49,11 @@ namespace core {
 				Spell{*data_.icon, env.id, data_.name}, data{data_}, world{env.world} {}
 
 			UsageResult cast(bool useMana = true) final {
-				if (useMana && !owner()->useMana(data.mana))
+				auto position = world->randomFreePosition(owner()->position().z);
+				if (!position || useMana && !owner()->useMana(data.mana))
 					return UsageResult::FAILURE;
 
-				owner()->position(world->randomPositionAt(owner()->position().z, [](const core::World& world, sf::Vector3i pos) {
-					return world.isFree(pos);
-				}));
+				owner()->position(*position);
 
 				return UsageResult::SUCCESS;
 			}
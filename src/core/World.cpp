@@ -17,59 +17,299 @@ If not, see <https://www.gnu.org/licenses/>. */
 
 #include "Actor.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <utility>
+
 namespace core {
-	std::shared_ptr<Actor> World::actorAt(sf::Vector3i position) {
-		auto iter = std::ranges::find_if(actors_, [position](std::shared_ptr<Actor> actor) {
-			return actor->isAlive() && actor->position() == position;
-		});
+	namespace {
+		void eraseActor(std::vector<Actor*>& actors, const Actor& actor) {
+			auto iter = std::ranges::find(actors, &actor);
+			TROTE_ASSERT(iter != actors.end());
+			*iter = actors.back();
+			actors.pop_back();
+		}
+	}
 
-		if (iter == actors_.end())
-			return nullptr;
-		return *iter;
+	void World::addActor(std::shared_ptr<Actor> actor) {
+		syncActorGrid();
+		indexActor(*actor);
+
+		changes_.addActorChange(ChangeJournal::ActorChange::Type::SPAWNED, actor->handle(), actor->position(), actor->position());
+
+		int id = static_cast<int>(actors_.size());
+		actorIds[actor.get()] = id;
+		if (actor->isAlive())
+			turnQueue.push(id, actor->nextTurn());
+		else
+			deadActors.push_back(actor.get());
+		actors_.push_back(std::move(actor));
+	}
+
+	void World::tile(sf::Vector3i position, Tile newTile) {
+		Tile oldTile = std::exchange(tiles_[position], newTile);
+		updateFreeCell(position);
+		changes_.addTileChange(position, oldTile, newTile);
+	}
+
+	void World::publishChanges() {
+		if (changes_.empty())
+			return;
+
+		onChanges(std::as_const(changes_));
+		changes_.clear();
+	}
+
+	void World::clearActors() {
+		actors_.clear();
+		actorIds.clear();
+		turnQueue.clear();
+		deadActors.clear();
+		levelActors.clear();
+		actorGrid.assign(actorGrid.shape(), nullptr);
+		actorBuckets.assign(actorBuckets.shape(), {});
+		freeCellsValid = false;
+	}
+
+	std::shared_ptr<Actor> World::actorAt(sf::Vector3i position) {
+		return std::const_pointer_cast<Actor>(std::as_const(*this).actorAt(position));
 	}
 
 	std::shared_ptr<const Actor> World::actorAt(sf::Vector3i position) const {
-		auto iter = std::ranges::find_if(actors_, [position](std::shared_ptr<Actor> actor) {
-			return actor->isAlive() && actor->position() == position;
+		Actor* actor = nullptr;
+		if (actorGrid.shape() == tiles().shape() && actorGrid.isValidPosition(position)) {
+			actor = actorGrid[position];
+		} else {
+			auto levelActors_ = actorsOnLevel(position.z);
+			auto iter = std::ranges::find_if(levelActors_, [position](const Actor* levelActor) {
+				return levelActor->isAlive() && levelActor->position() == position;
 			});
+			if (iter != levelActors_.end())
+				actor = *iter;
+		}
 
-		if (iter == actors_.end())
+		if (!actor || !actor->isAlive())
 			return nullptr;
-		return *iter;
+		return actor->shared_from_this();
 	}
 
-	void World::update() {
-		while (!actors_.empty()) {
-			popActor();
-
-			if (actors_.back()->isAlive()) {
-				bool complete = actors_.back()->controller().act();
-				pushActor();
-				if (!complete)
-					break;
+	std::vector<Actor*> World::actorsInRadius(sf::Vector3i position, double radius) const {
+		std::vector<Actor*> result;
+		auto isInRadius = [position, radius](const Actor* actor) {
+			return actor->position().z == position.z
+				&& util::distance(util::getXY(actor->position()), util::getXY(position)) <= radius;
+		};
+
+		if (actorGrid.shape() != tiles().shape()) {
+			std::ranges::copy_if(actorsOnLevel(position.z), std::back_inserter(result), isInRadius);
+			return result;
+		}
+
+		if (!actorBuckets.isValidZ(position.z))
+			return result;
+
+		auto offset = static_cast<int>(std::ceil(radius));
+		sf::Vector3i minBucket = bucketOf({std::max(position.x - offset, 0), std::max(position.y - offset, 0), position.z});
+		sf::Vector3i maxBucket = bucketOf({position.x + offset, position.y + offset, position.z});
+		maxBucket.x = std::min(maxBucket.x, actorBuckets.shape().x - 1);
+		maxBucket.y = std::min(maxBucket.y, actorBuckets.shape().y - 1);
+
+		for (int x = minBucket.x; x <= maxBucket.x; ++x)
+			for (int y = minBucket.y; y <= maxBucket.y; ++y)
+				std::ranges::copy_if(actorBuckets[{x, y, position.z}], std::back_inserter(result), isInRadius);
+		return result;
+	}
+
+	void World::actorMoved(Actor& actor, sf::Vector3i oldPosition) {
+		syncActorGrid();
+		if (!isIndexedAt(actor, oldPosition))
+			return;
+
+		unindexActor(actor, oldPosition);
+		indexActor(actor);
+		changes_.addActorChange(ChangeJournal::ActorChange::Type::MOVED, actor.handle(), oldPosition, actor.position());
+	}
+
+	void World::syncActorGrid() {
+		if (actorGrid.shape() == tiles().shape())
+			return;
+
+		sf::Vector3i shape = tiles().shape();
+		actorGrid.assign(shape, nullptr);
+		actorBuckets.assign({(shape.x + bucketSize - 1) / bucketSize, (shape.y + bucketSize - 1) / bucketSize, shape.z}, {});
+		for (const auto& actor : actors_) {
+			if (actorGrid.isValidPosition(actor->position())) {
+				actorBuckets[bucketOf(actor->position())].push_back(actor.get());
+				if (actor->isAlive())
+					actorGrid[actor->position()] = actor.get();
 			}
-			else {
-				bool interrupt = actors_.back()->controller().shouldInterruptOnDelete();
-				actors_.pop_back();
-				if (interrupt)
-					break;
+		}
+	}
+
+	void World::indexActor(Actor& actor) {
+		sf::Vector3i position = actor.position();
+		TROTE_ASSERT(position.z >= 0, "Actors should have nonnegative level");
+
+		if (position.z >= std::ssize(levelActors))
+			levelActors.resize(position.z + 1);
+		levelActors[position.z].push_back(&actor);
+
+		if (actorGrid.isValidPosition(position)) {
+			actorBuckets[bucketOf(position)].push_back(&actor);
+			if (actor.isAlive())
+				actorGrid[position] = &actor;
+		}
+		updateFreeCell(position);
+	}
+
+	void World::unindexActor(Actor& actor, sf::Vector3i position) {
+		eraseActor(levelActors[position.z], actor);
+
+		if (actorGrid.isValidPosition(position)) {
+			eraseActor(actorBuckets[bucketOf(position)], actor);
+			if (actorGrid[position] == &actor)
+				actorGrid[position] = nullptr;
+		}
+		updateFreeCell(position);
+	}
+
+	bool World::isIndexedAt(const Actor& actor, sf::Vector3i position) const {
+		if (actorGrid.isValidPosition(position))
+			return std::ranges::find(actorBuckets[bucketOf(position)], &actor) != actorBuckets[bucketOf(position)].end();
+		return std::ranges::find(actorsOnLevel(position.z), &actor) != actorsOnLevel(position.z).end();
+	}
+
+	void World::actorRescheduled(const Actor& actor) {
+		if (auto id = util::getOptional(actorIds, &actor); id && turnQueue.contains(*id))
+			turnQueue.update(*id, actor.nextTurn());
+	}
+
+	void World::actorDied(Actor& actor) {
+		if (auto id = util::getOptional(actorIds, &actor); id && turnQueue.contains(*id)) {
+			turnQueue.erase(*id);
+			deadActors.push_back(&actor);
+			changes_.addActorChange(ChangeJournal::ActorChange::Type::DIED, actor.handle(), actor.position(), actor.position());
+		}
+		updateFreeCell(actor.position());
+	}
+
+	void World::update() {
+		while (true) {
+			publishChanges();
+			if (removeDeadActors() || turnQueue.empty())
+				break;
+
+			int id = turnQueue.top();
+			Actor& actor = *actors_[id];
+			if (!actor.isAlive()) {
+				actorDied(actor);
+				continue;
 			}
+
+			bool complete = actor.controller().act();
+			++processedTurns_;
+			if (turnQueue.contains(id))
+				turnQueue.update(id, actor.nextTurn());
+			if (!complete)
+				break;
+		}
+		publishChanges();
+	}
+
+	bool World::removeDeadActors() {
+		bool interrupt = false;
+		for (Actor* actor : deadActors) {
+			interrupt |= actor->controller().shouldInterruptOnDelete();
+			removeActor(*actor);
+		}
+		deadActors.clear();
+		return interrupt;
+	}
+
+	void World::removeActor(Actor& actor) {
+		syncActorGrid();
+		unindexActor(actor, actor.position());
+
+		int id = actorIds.at(&actor);
+		actorIds.erase(&actor);
+		if (turnQueue.contains(id))
+			turnQueue.erase(id);
+
+		int lastId = static_cast<int>(actors_.size()) - 1;
+		if (id != lastId) {
+			actorIds[actors_.back().get()] = id;
+			turnQueue.relabel(lastId, id);
+			actors_[id] = std::move(actors_.back());
+		}
+		actors_.pop_back();
+	}
+
+	std::optional<sf::Vector3i> World::randomFreePosition(int level) {
+		syncFreeCells();
+		if (level < 0 || level >= std::ssize(freeCells) || freeCells[level].empty())
+			return std::nullopt;
+
+		const auto& levelCells = freeCells[level];
+		auto i = std::uniform_int_distribution<ptrdiff_t>{0, std::ssize(levelCells) - 1}(*randomEngine);
+		TROTE_ASSERT(isFree(levelCells[i]), "Free cell index is out of date. Call tilesChanged after changing tiles()");
+		return levelCells[i];
+	}
+
+	void World::syncFreeCells() {
+		if (freeCellsValid && freeCellIds.shape() == tiles().shape())
+			return;
+
+		syncActorGrid();
+		freeCellsValid = true;
+		freeCellIds.assign(tiles().shape(), -1);
+		freeCells.assign(tiles().shape().z, {});
+		for (int z = 0; z < tiles().shape().z; ++z)
+			for (int x = 0; x < tiles().shape().x; ++x)
+				for (int y = 0; y < tiles().shape().y; ++y)
+					if (isFree({x, y, z})) {
+						freeCellIds[{x, y, z}] = static_cast<int>(freeCells[z].size());
+						freeCells[z].push_back({x, y, z});
+					}
+	}
+
+	void World::updateFreeCell(sf::Vector3i position) {
+		if (!freeCellsValid || freeCellIds.shape() != tiles().shape() || !freeCellIds.isValidPosition(position))
+			return;
+
+		int& id = freeCellIds[position];
+		bool free = isFree(position);
+		if (free && id < 0) {
+			id = static_cast<int>(freeCells[position.z].size());
+			freeCells[position.z].push_back(position);
+		} else if (!free && id >= 0) {
+			auto& levelCells = freeCells[position.z];
+			freeCellIds[levelCells.back()] = id;
+			levelCells[id] = levelCells.back();
+			levelCells.pop_back();
+			id = -1;
 		}
 	}
 
 	void World::makeSound(Sound sound) {
-		for (auto actor : actors())
+		for (Actor* actor : actorsOnLevel(sound.position.z))
 			actor->controller().handleSound(sound);
 	}
 
 	void World::generateStairs() {
 		upStairs_.clear();
 		downStairs_.clear();
+		stairLinks.assign(tiles().shape(), 0);
+		stairDestinations.clear();
 		const int max_tries = 1000;
+		auto isEmptyTile = [](const World& world, sf::Vector3i pos) {
+			return isEmpty(world.tile(pos));
+		};
 		for (int z = 1; z < tiles().shape().z; ++z)
 			for (int i = 0; i < 3; ++i)
-				if (auto pos1 = randomPositionAt(z - 1, max_tries, &isEmpty))
-					if (auto pos2 = randomPositionAt(z, max_tries, &isEmpty))
+				if (auto pos1 = randomFreePosition(z - 1, max_tries, isEmptyTile))
+					if (auto pos2 = randomFreePosition(z, max_tries, isEmptyTile))
 						addStairs(*pos1, *pos2);
 	}
 
@@ -80,21 +320,32 @@ namespace core {
 		}
 
 		downStairs_.insert_or_assign(pos1, pos2);
-		tiles()[pos1] = Tile::DOWN_STAIRS;
+		tile(pos1, Tile::DOWN_STAIRS);
 
 		upStairs_.insert_or_assign(pos2, pos1);
-		tiles()[pos2] = Tile::UP_STAIRS;
-	}
+		tile(pos2, Tile::UP_STAIRS);
 
-	void World::pushActor() {
-		std::ranges::push_heap(actors_, std::greater<>{}, [](std::shared_ptr<Actor>& actor) {
-			return actor->nextTurn();
-		});
+		if (stairLinks.shape() != tiles().shape()) {
+			stairLinks.assign(tiles().shape(), 0);
+			stairDestinations.clear();
+			for (const auto& [position, destination] : upStairs_)
+				linkStairs(position, destination);
+			for (const auto& [position, destination] : downStairs_)
+				linkStairs(position, destination);
+		} else {
+			linkStairs(pos1, pos2);
+			linkStairs(pos2, pos1);
+		}
 	}
 
-	void World::popActor() {
-		std::ranges::pop_heap(actors_, std::greater<>{}, [](std::shared_ptr<Actor>& actor) {
-			return actor->nextTurn();
-		});
+	void World::linkStairs(sf::Vector3i position, sf::Vector3i destination) {
+		if (int link = stairLinks[position]) {
+			stairDestinations[link - 1] = destination;
+			return;
+		}
+
+		TROTE_ASSERT(stairDestinations.size() < std::numeric_limits<uint16_t>::max(), "Too many stairs");
+		stairDestinations.push_back(destination);
+		stairLinks[position] = static_cast<uint16_t>(stairDestinations.size());
 	}
 }
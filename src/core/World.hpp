@@ -17,20 +17,29 @@ If not, see <https://www.gnu.org/licenses/>. */
 #define WORLD_HPP_
 
 #include "Tile.hpp"
+#include "ActorHandle.hpp"
+#include "ChangeJournal.hpp"
 #include "Sound.hpp"
 #include "fwd.hpp"
 #include "Position.hpp"
 #include "Item.hpp"
 
 #include "util/Array3D.hpp"
+#include "util/IndexedHeap.hpp"
 #include "util/Map.hpp"
+#include "util/Signal.hpp"
 #include "util/random.hpp"
 
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/System/Vector3.hpp>
 
+#include <cstdint>
+#include <functional>
+#include <optional>
 #include <queue>
 #include <span>
+#include <utility>
+#include <vector>
 
 namespace core {
 	/// Dungeons and all objects in it
@@ -47,21 +56,69 @@ namespace core {
 			return tiles_;
 		}
 
-		/// Add Actor to list
-		void addActor(std::shared_ptr<Actor> actor) {
-			actors_.push_back(std::move(actor));
-			pushActor();
+		[[nodiscard]] Tile tile(sf::Vector3i position) const {
+			return tiles_[position];
 		}
 
-		/// Remove all actors
-		void clearActors() {
-			actors_.clear();
+		/// @brief Changes single tile
+		/// @details Unlike tiles()[position] = newTile keeps tile dependent indices up to date
+		void tile(sf::Vector3i position, Tile newTile);
+
+		/// @brief Invalidates tile dependent indices and journals change of all tiles
+		/// @details Should be called after tiles were changed through tiles()
+		void tilesChanged() {
+			freeCellsValid = false;
+			changes_.markAllTilesChanged(tiles_.shape());
+		}
+
+		/// Changes that weren't published yet
+		[[nodiscard]] const ChangeJournal& changes() const noexcept {
+			return changes_;
+		}
+
+		/// @brief Adds listener called with ChangeJournal when changes are published
+		/// @details Changes are published by update before each Actor turn and after the last one.
+		/// Code changing tiles outside of update (e. g. player input) should call publishChanges itself
+		void addChangeListener(std::function<void(const ChangeJournal&)> listener) {
+			onChanges.addListener(std::move(listener));
 		}
 
+		/// Notifies change listeners and clears ChangeJournal if there are changes
+		void publishChanges();
+
+		/// Slots referenced by ActorHandles of Actors created with this World
+		[[nodiscard]] ActorTable& actorTable() noexcept {
+			return actorTable_;
+		}
+
+		/// Slots referenced by ActorHandles of Actors created with this World
+		[[nodiscard]] const ActorTable& actorTable() const noexcept {
+			return actorTable_;
+		}
+
+		/// Add Actor to list
+		void addActor(std::shared_ptr<Actor> actor);
+
+		/// Remove all actors
+		void clearActors();
+
 		[[nodiscard]] std::span<const std::shared_ptr<Actor>> actors() const {
 			return actors_;
 		}
 
+		/// @brief Actors on given level
+		/// @details Includes dead actors that aren't removed yet.
+		/// Don't move actors between levels while iterating
+		[[nodiscard]] std::span<Actor* const> actorsOnLevel(int z) const {
+			if (z < 0 || z >= std::ssize(levelActors))
+				return {};
+			return levelActors[z];
+		}
+
+		/// @brief Actors on position level with horizontal euclidian distance to position not greater than radius
+		/// @details Includes dead actors that aren't removed yet
+		[[nodiscard]] std::vector<Actor*> actorsInRadius(sf::Vector3i position, double radius) const;
+
 		/// @brief Gets Actor at given position if it exist
 		/// @warning May return nullptr
 		[[nodiscard]] std::shared_ptr<Actor> actorAt(sf::Vector3i position);
@@ -83,14 +140,29 @@ namespace core {
 			return actorAt(util::make3D(position.xy(), position.z));
 		}
 
+		/// @brief Updates actor indices after actor changed its position
+		/// @details Called by Actor::position. Does nothing if actor isn't registered in this World
+		void actorMoved(Actor& actor, sf::Vector3i oldPosition);
+
+		/// @brief Reschedules actor after its nextTurn was changed outside of its turn
+		/// @details Called by Actor::nextTurn. Does nothing if actor isn't scheduled in this World
+		void actorRescheduled(const Actor& actor);
+
+		/// @brief Unschedules dead actor. It's removed on the next update
+		/// @details Called by Actor when it dies. Does nothing if actor isn't scheduled in this World
+		void actorDied(Actor& actor);
+
 		/// Add Item to list
 		void addItem(core::Position<int> position, std::unique_ptr<Item> item) {
 			items_.emplace(position, std::move(item));
+			updateFreeCell(static_cast<sf::Vector3i>(position));
+			changes_.addItemChange(ChangeJournal::ItemChange::Type::ADDED, static_cast<sf::Vector3i>(position));
 		}
 
 		/// Remove all items
 		void clearItems() {
 			items_.clear();
+			freeCellsValid = false;
 		}
 
 		[[nodiscard]] const util::UnorderedMap<core::Position<int>, std::unique_ptr<Item>>& items() const {
@@ -101,6 +173,8 @@ namespace core {
 			if (auto iter = items_.find(position); iter != items_.end()) {
 				auto item = std::move(iter->second);
 				items_.erase(iter);
+				updateFreeCell(static_cast<sf::Vector3i>(position));
+				changes_.addItemChange(ChangeJournal::ItemChange::Type::REMOVED, static_cast<sf::Vector3i>(position));
 				return item;
 			}
 			return nullptr;
@@ -109,6 +183,11 @@ namespace core {
 		/// Updates actors until one of them decides to wait input
 		void update();
 
+		/// Total number of Controller::act calls made by update. Used for profiling
+		[[nodiscard]] std::int64_t processedTurns() const noexcept {
+			return processedTurns_;
+		}
+
 		/// Tile isPassable and have no Actors on it
 		[[nodiscard]] bool isFree(sf::Vector3i position) const {
 			return isPassable(tiles()[position]) 
@@ -118,6 +197,28 @@ namespace core {
 
 		void makeSound(Sound sound);
 
+		/// @brief Uniformly distributed random free position at given level
+		/// @details Picks from the index of free tiles so always terminates.
+		/// Index is rebuilt lazily after tilesChanged
+		/// @returns nullopt if there are no free tiles on level
+		[[nodiscard]] std::optional<sf::Vector3i> randomFreePosition(int level);
+
+		/// @brief Random free position at given level satisfying pred(*this, pos)
+		/// @details randomFreePosition(level) distribution filtered by pred
+		/// @param tries Max amount of positions to check before returning nullopt
+		template <typename Pred>
+			requires std::convertible_to<std::invoke_result_t<Pred, const World&, sf::Vector3i>, bool>
+		[[nodiscard]] std::optional<sf::Vector3i> randomFreePosition(int level, int tries, Pred&& pred) {
+			for (int i = 0; i < tries; ++i) {
+				auto pos = randomFreePosition(level);
+				if (!pos)
+					return std::nullopt;
+				if (std::invoke(pred, std::as_const(*this), *pos))
+					return pos;
+			}
+			return std::nullopt;
+		}
+
 		/// @brief Random tile position
 		/// @details position distribution is uniform and independent for both dimensions
 		[[nodiscard]] sf::Vector3i randomPositionAt(int level) const {
@@ -194,6 +295,18 @@ namespace core {
 			return util::getOptional(downStairs(), position);
 		}
 
+		/// @brief Destination of up or down stairs at position
+		/// @details Reads dense per tile index so it's cheap enough for pathfinding inner loops
+		[[nodiscard]] std::optional<sf::Vector3i> stairsDestination(sf::Vector3i position) const {
+			if (!stairLinks.isValidPosition(position))
+				return std::nullopt;
+
+			int link = stairLinks[position];
+			if (!link)
+				return std::nullopt;
+			return stairDestinations[link - 1];
+		}
+
 		/// @brief Create stairs between position1 and position2
 		/// @details Sets tiles and registers stairs in maps.
 		/// Up or down stairs are choosen automatically by z coordinate.
@@ -229,17 +342,90 @@ namespace core {
 		util::UnorderedMap<sf::Vector3i, sf::Vector3i> upStairs_;
 		util::UnorderedMap<sf::Vector3i, sf::Vector3i> downStairs_;
 
+		/// @brief 1 + index in stairDestinations for each stairs tile, 0 for other tiles
+		/// @details Same shape as tiles_ after addStairs
+		util::Array3D<uint16_t> stairLinks;
+		std::vector<sf::Vector3i> stairDestinations;
+
 		std::vector<std::vector<sf::IntRect>> areas_;
 
+		ActorTable actorTable_;
+
 		std::vector<std::shared_ptr<Actor>> actors_;
 		std::shared_ptr<Actor> player_;
 
+		/// Indices of actors in actors_
+		util::UnorderedMap<const Actor*, int> actorIds;
+
+		/// Alive actors keyed by nextTurn. Ids are indices in actors_
+		util::IndexedHeap<double> turnQueue;
+		std::int64_t processedTurns_ = 0;
+
+		/// Actors died since last update. Removed on the next update
+		std::vector<Actor*> deadActors;
+
+		/// @brief Actor occupying each tile or nullptr
+		/// @details Same shape as tiles_. Slots may hold dead actors until they are removed from actors_
+		util::Array3D<Actor*> actorGrid;
+
+		/// Actors partitioned by level
+		std::vector<std::vector<Actor*>> levelActors;
+
+		/// Side of the square covered by one actorBuckets cell
+		static const int bucketSize = 8;
+
+		/// @brief Uniform grid of actors used for range queries
+		/// @details Synced with actorGrid. Actors outside of tiles_ bounds aren't stored
+		util::Array3D<std::vector<Actor*>> actorBuckets;
+
 		util::UnorderedMap<core::Position<int>, std::unique_ptr<Item>> items_;
 
+		/// Free positions partitioned by level. Unordered
+		std::vector<std::vector<sf::Vector3i>> freeCells;
+
+		/// @brief Index of each tile in freeCells or -1 if it isn't free
+		/// @details Same shape as tiles_
+		util::Array3D<int> freeCellIds;
+
+		/// If false freeCells and freeCellIds are rebuilt before next use
+		bool freeCellsValid = false;
+
+		ChangeJournal changes_;
+		util::Signal<const ChangeJournal&> onChanges;
+
 		util::RandomEngine* randomEngine = nullptr;
 
-		void pushActor();
-		void popActor();
+		/// @brief Removes dead actors
+		/// @returns true if one of them should interrupt update
+		bool removeDeadActors();
+
+		/// Removes actor from actors_ and all indices
+		void removeActor(Actor& actor);
+
+		/// Rebuilds actorGrid and actorBuckets if tiles were reshaped
+		void syncActorGrid();
+
+		/// Adds actor to all indices using its current position
+		void indexActor(Actor& actor);
+
+		/// Removes actor registered at position from all indices
+		void unindexActor(Actor& actor, sf::Vector3i position);
+
+		/// Checks if actor is registered at position
+		[[nodiscard]] bool isIndexedAt(const Actor& actor, sf::Vector3i position) const;
+
+		[[nodiscard]] static sf::Vector3i bucketOf(sf::Vector3i position) noexcept {
+			return {position.x / bucketSize, position.y / bucketSize, position.z};
+		}
+
+		/// Sets stairs link at position to destination
+		void linkStairs(sf::Vector3i position, sf::Vector3i destination);
+
+		/// Rebuilds freeCells and freeCellIds if they aren't valid
+		void syncFreeCells();
+
+		/// Adds position to freeCells or removes it from them if isFree changed
+		void updateFreeCell(sf::Vector3i position);
 	};
 }
 
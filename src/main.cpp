@@ -14,6 +14,7 @@ You should have received a copy of the GNU General Public License along with the
 If not, see <https://www.gnu.org/licenses/>. */
 
 #include "Game.hpp"  
+#include "InputLog.hpp"
 
 #include "core/ActorSpawner.hpp"
 
@@ -38,6 +39,8 @@ If not, see <https://www.gnu.org/licenses/>. */
 #include <boost/di.hpp>
 
 #include <cstdlib> 
+#include <optional>
+#include <string_view>
 
 sf::String createSfString(std::string_view string) {
     return sf::String::fromUtf8(std::ranges::begin(string), 
@@ -52,23 +55,72 @@ sf::String createSfString(std::string_view string) {
     );
 }
 
-int main() {
+/// Command line options
+struct Options {
+    /// Log file to record seed and input to
+    std::optional<std::string_view> recordPath;
+
+    /// Log file to replay instead of playing
+    std::optional<std::string_view> replayPath;
+};
+
+/// Error in command line arguments
+class ArgumentsError : public util::RuntimeError {
+    using util::RuntimeError::RuntimeError;
+};
+
+/// @brief Parses --record <file> and --replay <file> options
+/// @throws ArgumentsError
+[[nodiscard]] Options parseOptions(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if ((arg == "--record" || arg == "--replay") && i + 1 < argc) {
+            (arg == "--record" ? options.recordPath : options.replayPath) = argv[++i];
+        } else {
+            throw ArgumentsError{std::format("Unknown argument {}", arg)};
+        }
+    }
+
+    if (options.recordPath && options.replayPath)
+        throw ArgumentsError{"Can't record and replay at the same time"};
+    return options;
+}
+
+int main(int argc, char* argv[]) {
     auto logModule_ = logModule();
     auto loggerFactory = logModule_.create<util::LoggerFactory>();
     auto logger = loggerFactory.create("main");   
 
     try {
+        Options options = parseOptions(argc, argv);
+        std::optional<InputReplay> replay;
+        if (options.replayPath)
+            replay.emplace(*options.replayPath);
+
         logger->info("Loading...");
 
         auto videoMode = sf::VideoMode::getDesktopMode();
-        auto renderWindow = std::make_shared<sf::RenderWindow>(
-            videoMode, 
-            createSfString("The Rune of the Eldest"), 
-            sf::Style::Fullscreen
-        );
-        renderWindow->setVerticalSyncEnabled(true);
-
-        util::SeedT seed = std::random_device{}();
+        std::shared_ptr<sf::RenderWindow> renderWindow;
+        if (replay) {
+            // Replay doesn't render but needs a window of the recorded size to map mouse clicks
+            videoMode = sf::VideoMode{replay->windowSize().x, replay->windowSize().y};
+            renderWindow = std::make_shared<sf::RenderWindow>(
+                videoMode,
+                createSfString("The Rune of the Eldest (replay)"),
+                sf::Style::None
+            );
+            renderWindow->setVisible(false);
+        } else {
+            renderWindow = std::make_shared<sf::RenderWindow>(
+                videoMode, 
+                createSfString("The Rune of the Eldest"), 
+                sf::Style::Fullscreen
+            );
+            renderWindow->setVerticalSyncEnabled(true);
+        }
+
+        util::SeedT seed = replay ? replay->seed() : std::random_device{}();
         util::RandomEngine randomEngine{seed};
         logger->info("Random seed is {}", seed);
 
@@ -87,7 +139,15 @@ int main() {
         game.dungeonGenerator().minSize(2);
 
         logger->info("Loading complete");
-        game.run();
+        if (replay) {
+            game.replay(*replay);
+        } else {
+            if (options.recordPath) {
+                logger->info("Recording input to {}", *options.recordPath);
+                game.recorder(std::make_unique<InputRecorder>(*options.recordPath, seed, renderWindow->getSize()));
+            }
+            game.run();
+        }
         logger->info("Exiting...");
     } catch (const util::TracableException& e) {
         logger->critical("Error occured: {}\nStacktrace:\n{}", 
@@ -0,0 +1,46 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "regenerateDungeon.hpp"
+
+#include "generation/DungeonGenerator.hpp"
+
+#include "core/World.hpp"
+#include "core/ActorSpawner.hpp"
+#include "core/ItemManager.hpp"
+
+void regenerateDungeon(core::World& world, core::ItemManager& items, generation::DungeonGenerator& dungeonGenerator,
+                       core::ActorSpawner& actorSpawner, spdlog::logger& logger) {
+    logger.info("Started");
+
+    logger.info("Resetting world...");
+    world.clearActors();
+    world.clearItems();
+    items.clearIdentifiedItems();
+    items.randomizeTextures();
+    world.tiles().assign({ 50, 50, 10 }, core::Tile::WALL);
+
+    logger.info("Generating dungeon...");
+    dungeonGenerator();
+    world.tilesChanged();
+
+    logger.info("Generating stairs...");
+    world.generateStairs();
+
+    actorSpawner.spawn();
+    items.spawn();
+
+    logger.info("Finished");
+}
@@ -0,0 +1,31 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#ifndef REGENERATE_DUNGEON_HPP_
+#define REGENERATE_DUNGEON_HPP_
+
+#include "core/fwd.hpp"
+#include "generation/fwd.hpp"
+
+#include "util/log.hpp"
+
+/// @brief Replaces dungeon in world with newly generated one
+/// @details Clears actors and items, generates tiles and stairs and spawns new actors and items.
+/// Shared by Game and the headless simulation so both play the same dungeons.
+/// Caches of the old dungeon (Raycaster, Pathfinder, PlayerMap etc.) should be reset by the caller
+void regenerateDungeon(core::World& world, core::ItemManager& items, generation::DungeonGenerator& dungeonGenerator,
+                       core::ActorSpawner& actorSpawner, spdlog::logger& logger);
+
+#endif
\ No newline at end of file
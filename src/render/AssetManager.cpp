@@ -23,9 +23,9 @@ If not, see <https://www.gnu.org/licenses/>. */
 #include <string_view>
 
 namespace render {
-    AssetManager::AssetManager(util::LoggerFactory& loggerFactory, util::RandomEngine& randomEngine_) : 
-            logger{loggerFactory.create("assets")}, randomEngine{&randomEngine_} {
-        logger->info("Loading textures...");
+    AssetManager::AssetManager(bool placeholders, util::LoggerFactory& loggerFactory, util::RandomEngine& randomEngine_) : 
+            placeholders_{placeholders}, randomEngine{&randomEngine_}, logger{loggerFactory.create("assets")} {
+        logger->info(placeholders_ ? "Creating placeholder textures..." : "Loading textures...");
 
         loadTexture(tileTextureMut(core::Tile::EMPTY), "floor tile texture", "resources/textures/Tiles/floor.png");
         loadTexture(tileTextureMut(core::Tile::WALL), "wall tile texture", "resources/textures/Tiles/wall.png");
@@ -72,6 +72,9 @@ namespace render {
     }
 
     void AssetManager::loadTexture(sf::Texture& texture, std::string_view name, const std::filesystem::path& path) const {
+        if (placeholders_)
+            return;
+
         logger->info("Loading {}...", name);
         if (!texture.loadFromFile(path.generic_string()))
             throw TextureLoadError{ std::format("Unable to load {}", name) };
@@ -79,7 +82,7 @@ namespace render {
 
     [[nodiscard]] const sf::Texture& AssetManager::scrollTexture(const sf::Texture& spellIcon) const {
         sf::RenderTexture& result = scrollTextureCache[&spellIcon];
-        if (result.getSize() == sf::Vector2u{0, 0}) {
+        if (!placeholders_ && result.getSize() == sf::Vector2u{0, 0}) {
             const sf::Texture& base = texture("resources/textures/scroll.png");
             result.create(2 * base.getSize().x, 2 * base.getSize().y);
 
@@ -94,7 +97,7 @@ namespace render {
 
     [[nodiscard]] const sf::Texture& AssetManager::potionTexture(const sf::Texture& base, const sf::Texture& label) const {
         sf::RenderTexture& result = potionTextureCache[{&base, &label}];
-        if (result.getSize() == sf::Vector2u{0, 0}) {
+        if (!placeholders_ && result.getSize() == sf::Vector2u{0, 0}) {
             result.create(base.getSize().x, base.getSize().y);
 
             result.clear(sf::Color::Transparent);
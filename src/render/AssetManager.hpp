@@ -34,6 +34,7 @@ If not, see <https://www.gnu.org/licenses/>. */
 #include <SFML/Graphics/Font.hpp>
 
 #include <filesystem>
+#include <memory>
 
 namespace render {
 	/// Loads and manages textures
@@ -56,7 +57,16 @@ namespace render {
 
 		/// @brief creates AssetManager and loads textures
 		/// @throws AssetManager::TextureLoadError
-		AssetManager(util::LoggerFactory& loggerFactory, util::RandomEngine& randomEngine);
+		AssetManager(util::LoggerFactory& loggerFactory, util::RandomEngine& randomEngine) :
+			AssetManager{false, loggerFactory, randomEngine} {}
+
+		/// @brief Creates AssetManager with empty placeholder textures
+		/// @details Placeholders don't need OpenGL context or display, so headless simulation can run without them.
+		/// They are still cached by path, so they can be parsed and stringified like loaded textures
+		[[nodiscard]] static std::shared_ptr<AssetManager> placeholders(util::LoggerFactory& loggerFactory,
+		                                                                util::RandomEngine& randomEngine) {
+			return std::shared_ptr<AssetManager>{new AssetManager{true, loggerFactory, randomEngine}};
+		}
 
 		/// @brief Gets texture from given file
 		/// @details Loads texture from given file and caches it
@@ -103,6 +113,9 @@ namespace render {
 		[[nodiscard]] const sf::Texture& parse(std::string_view data) const;
 		[[nodiscard]] std::string stringify(const sf::Texture& texture) const;
 	private:
+		/// If true textures are never loaded to GPU
+		bool placeholders_;
+
 		mutable util::UnorderedMap<std::filesystem::path, sf::Texture> textureCache;
 
 		inline const static sf::Vector2i tileSize_{ 16, 16 };
@@ -135,8 +148,13 @@ namespace render {
 			return soundIcons[static_cast<ptrdiff_t>(type) * 2 + static_cast<ptrdiff_t>(isSourceOnPlayerSide)];
 		}
 
+		AssetManager(bool placeholders, util::LoggerFactory& loggerFactory, util::RandomEngine& randomEngine);
+
 		void fillTexture(sf::Texture& texture,
 			sf::Vector2i size, sf::Color color) const noexcept {
+			if (placeholders_)
+				return;
+
 			sf::Image image;
 			image.create(size.x, size.y, color);
 			texture.loadFromImage(image);
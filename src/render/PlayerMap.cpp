@@ -19,16 +19,16 @@ If not, see < https://www.gnu.org/licenses/>. */
 
 #include "core/World.hpp"
 
-#include "util/raycast.hpp"
 #include "util/Direction.hpp"
 #include "util/parse.hpp"
 #include "util/parseKeyValue.hpp"
 #include "util/stringify.hpp"
 
+#include <bit>
+
 namespace render {
-	PlayerMap::PlayerMap(std::shared_ptr<core::World> world_, std::shared_ptr<AssetManager> assets_, 
-						 std::shared_ptr<util::Raycaster> raycaster_) :
-		world{ std::move(world_) }, assets{std::move(assets_)}, raycaster{std::move(raycaster_)} {}
+	PlayerMap::PlayerMap(std::shared_ptr<core::World> world_, std::shared_ptr<AssetManager> assets_) :
+		world{ std::move(world_) }, assets{std::move(assets_)} {}
 
 	const bool seeEverything = false;
 
@@ -38,25 +38,61 @@ namespace render {
 		clearSounds();
 
 		tileStates.assign(world->tiles().shape(), seeEverything ? TileState::VISIBLE : TileState::UNSEEN);
+		tilesDirty = true;
+		fovDirty = true;
+		unseenDistancesValid = false;
+		revealedTiles.clear();
+		visibleTiles.clear();
+	}
+
+	void PlayerMap::update() {
+		if (tilesDirty || lastPlayerPosition != world->player().position()) {
+			updateTiles();
+			tilesDirty = false;
+			lastPlayerPosition = world->player().position();
+		}
+		updateActors();
+		updateItems();
+	}
+
+	bool PlayerMap::canSee(core::Position<int> position) const {
+		if (seeEverything)
+			return true;
+
+		updateFov();
+		return fov.isVisible(static_cast<sf::Vector3i>(position));
 	}
 
-	bool PlayerMap::canSee(core::Position<int> position) const noexcept {
-		return seeEverything || raycaster->canSee(world->player().position(), static_cast<sf::Vector3i>(position));
+	void PlayerMap::updateFov() const {
+		if (fovDirty || fov.origin() != world->player().position()) {
+			fov.compute(*world, world->player().position());
+			fovDirty = false;
+		}
 	}
 
 	void PlayerMap::updateTiles() {
 		if (seeEverything)
 			return;
 
-		auto [shapeX, shapeY, shapeZ] = world->tiles().shape();
-		for (int z = 0; z < shapeZ; ++z) {
-			for (int x = 0; x < shapeX; ++x)
-				for (int y = 0; y < shapeY; ++y)
-					if (canSee({ x, y, z }))
-						tileStates[{ x, y, z }] = TileState::VISIBLE;
-					else if (tileState({ x, y, z }) == TileState::VISIBLE)
-						tileStates[{ x, y, z }] = TileState::MEMORIZED;
-		}
+		updateFov();
+
+		for (sf::Vector3i position : visibleTiles)
+			if (!fov.isVisible(position))
+				tileStates[position] = TileState::MEMORIZED;
+		visibleTiles.clear();
+
+		int shapeX = world->tiles().shape().x;
+		int z = fov.origin().z;
+		auto bits = fov.bits();
+		for (ptrdiff_t word = 0; word < std::ssize(bits); ++word)
+			for (std::uint64_t rest = bits[word]; rest; rest &= rest - 1) {
+				ptrdiff_t index = word * 64 + std::countr_zero(rest);
+				sf::Vector3i position{ static_cast<int>(index % shapeX), static_cast<int>(index / shapeX), z };
+				if (unseenDistancesValid && tileStates[position] == TileState::UNSEEN)
+					revealedTiles.push_back(position);
+				tileStates[position] = TileState::VISIBLE;
+				visibleTiles.push_back(position);
+			}
 	}
 
 	void PlayerMap::updateActors() {
@@ -64,12 +100,21 @@ namespace render {
 			return canSee(actor.position);
 		});
 
-		for (const auto& actor : world->actors())
-			if (actor->isAlive() && canSee(core::Position<int>{actor->position()}))
-				seenActors_.emplace_back(core::Position<int>{actor->position()},
-										 actor->hp(), actor->maxHp(), 
-										 actor->mana(), actor->maxMana(),
-					                     actor->controller().aiState(), actor->texture());
+		auto updateActor = [this](const core::Actor& actor) {
+			if (actor.isAlive() && canSee(core::Position<int>{actor.position()}))
+				seenActors_.emplace_back(core::Position<int>{actor.position()},
+										 actor.hp(), actor.maxHp(), 
+										 actor.mana(), actor.maxMana(),
+					                     actor.controller().aiState(), actor.texture());
+		};
+
+		if (seeEverything) {
+			for (const auto& actor : world->actors())
+				updateActor(*actor);
+		} else {
+			for (const core::Actor* actor : world->actorsOnLevel(world->player().position().z))
+				updateActor(*actor);
+		}
 
 		std::ranges::sort(seenActors_, {}, [](SeenActor actor) {
 			return actor.position.y;
@@ -99,10 +144,34 @@ namespace render {
 						return world->tiles().isValidPosition(pos) && world->tiles()[pos] != core::Tile::WALL;
 					})) {
 						tileStates[{ x, y, z }] = TileState::MEMORIZED;
+						if (unseenDistancesValid)
+							revealedTiles.push_back({ x, y, z });
 					}
 				}
 	}
 
+	std::optional<sf::Vector3i> PlayerMap::nextExploreStep(sf::Vector3i position) {
+		if (!unseenDistancesValid) {
+			std::vector<sf::Vector3i> unseenTiles;
+			auto [shapeX, shapeY, shapeZ] = world->tiles().shape();
+			for (int z = 0; z < shapeZ; ++z)
+				for (int y = 0; y < shapeY; ++y)
+					for (int x = 0; x < shapeX; ++x)
+						if (tileStates[{ x, y, z }] == TileState::UNSEEN && core::isPassable(world->tiles()[{ x, y, z }]))
+							unseenTiles.push_back({ x, y, z });
+
+			unseenDistances.compute(*world, unseenTiles);
+			unseenDistancesValid = true;
+		} else {
+			unseenDistances.removeSources(*world, revealedTiles);
+		}
+		revealedTiles.clear();
+
+		if (unseenDistances.distance(position) == util::DistanceField::unreached)
+			return std::nullopt;
+		return unseenDistances.nextStep(*world, position);
+	}
+
 	void PlayerMap::discoverLevelActors(int z) {
 		if (seeEverything)
 			return;
@@ -111,8 +180,8 @@ namespace render {
 			return actor.position.z == z;
 		});
 
-		for (const auto& actor : world->actors())
-			if (actor->isAlive() && actor->position().z == z)
+		for (const core::Actor* actor : world->actorsOnLevel(z))
+			if (actor->isAlive())
 				seenActors_.emplace_back(core::Position<int>{actor->position()},
 					actor->hp(), actor->maxHp(),
 					actor->mana(), actor->maxMana(),
@@ -161,6 +230,10 @@ namespace render {
 		} else {
 			tileStates = newTileStates;
 		}
+		tilesDirty = true;
+		unseenDistancesValid = false;
+		revealedTiles.clear();
+		visibleTiles.clear();
 	}
 
 	[[nodiscard]] std::string PlayerMap::stringifyTileStates() const {
@@ -20,7 +20,8 @@ If not, see < https://www.gnu.org/licenses/>. */
 #include "core/Actor.hpp"
 
 #include "util/Array3D.hpp"
-#include "util/raycast.hpp"
+#include "util/FieldOfView.hpp"
+#include "util/pathfinding.hpp"
 
 #include <JutchsON.hpp>
 
@@ -31,12 +32,12 @@ If not, see < https://www.gnu.org/licenses/>. */
 #include <vector>
 #include <span>
 #include <memory>
+#include <optional>
 
 namespace render {
 	class PlayerMap {
 	public:
-		PlayerMap(std::shared_ptr<core::World> world, std::shared_ptr<AssetManager> assets, 
-				  std::shared_ptr<util::Raycaster> raycaster);
+		PlayerMap(std::shared_ptr<core::World> world, std::shared_ptr<AssetManager> assets);
 
 		enum class TileState {
 			UNSEEN,
@@ -76,16 +77,36 @@ namespace render {
 			return seenItems_;
 		}
 
-		[[nodiscard]] bool canSee(core::Position<int> position) const noexcept;
+		/// @brief Checks if player can see tile at position
+		/// @details Reads field of view from the player position. It's recomputed if player moved or tiles changed,
+		/// so the answer always matches VISIBLE tiles of the next update
+		[[nodiscard]] bool canSee(core::Position<int> position) const;
 
 		void onGenerate();
 
-		void update() {
-			updateTiles();
-			updateActors();
-			updateItems();
+		/// @brief Marks tile states for recomputation if tiles changed
+		/// @details Should be subscribed to World changes
+		void onChanges(const core::ChangeJournal& changes) {
+			tilesDirty |= changes.tilesChanged();
+			fovDirty |= changes.tilesChanged();
+			if (changes.tilesChanged()) {
+				unseenDistancesValid = false;
+				revealedTiles.clear();
+			}
 		}
 
+		/// @brief Computes next move to the nearest reachable unseen tile
+		/// @details Distances to unseen tiles are computed once and then repaired only around revealed tiles,
+		/// so exploring costs nearly constant time per step
+		/// @returns std::nullopt if there are no reachable unseen tiles
+		[[nodiscard]] std::optional<sf::Vector3i> nextExploreStep(sf::Vector3i position);
+
+		/// @brief Updates seen actors, items and tiles
+		/// @details Tile states are recomputed only if tiles changed or player moved
+		void update();
+
+		/// @brief Marks tiles in field of view VISIBLE and previously visible ones MEMORIZED
+		/// @details Visits only the previously visible tiles and the set bits of the field of view
 		void updateTiles();
 
 		void discoverLevelTiles(int z);
@@ -124,6 +145,19 @@ namespace render {
 		}
 	private:
 		util::Array3D<TileState> tileStates;
+		bool tilesDirty = true;
+
+		util::DistanceField unseenDistances;
+		bool unseenDistancesValid = false;
+
+		/// Tiles which stopped being unseen since unseenDistances were updated
+		std::vector<sf::Vector3i> revealedTiles;
+		std::optional<sf::Vector3i> lastPlayerPosition;
+
+		/// Tiles set VISIBLE by the last updateTiles, so only they and the new field of view are visited
+		std::vector<sf::Vector3i> visibleTiles;
+		mutable util::FieldOfView fov;
+		mutable bool fovDirty = true;
 		std::vector<SeenActor> seenActors_;
 		std::vector<SeenItem> seenItems_;
 
@@ -131,7 +165,9 @@ namespace render {
 
 		std::shared_ptr<core::World> world;
 		std::shared_ptr<AssetManager> assets;
-		std::shared_ptr<util::Raycaster> raycaster;
+
+		/// Recomputes field of view if player moved or tiles changed since it was computed
+		void updateFov() const;
 
 		void updateActors();
 		void updateItems();
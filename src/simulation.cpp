@@ -0,0 +1,147 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+/// @file simulation.cpp Headless simulation used for profiling World::update without a window
+
+#include "core/World.hpp"
+#include "core/Actor.hpp"
+#include "core/ActorSpawner.hpp"
+#include "core/ItemManager.hpp"
+#include "core/XpManager.hpp"
+#include "core/EffectManager.hpp"
+#include "core/Spell/Manager.hpp"
+#include "core/Controller/RandomPlayerController.hpp"
+
+#include "generation/DungeonGenerator.hpp"
+
+#include "render/AssetManager.hpp"
+#include "render/ParticleManager.hpp"
+#include "render/PlayerMap.hpp"
+#include "render/Context.hpp"
+
+#include "regenerateDungeon.hpp"
+
+#include "util/log.hpp"
+#include "util/Exception.hpp"
+#include "util/parse.hpp"
+#include "util/pathfinding.hpp"
+#include "util/random.hpp"
+#include "util/raycast.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+
+namespace {
+    const std::int64_t defaultTurns = 10000;
+}
+
+/// @brief Runs World::update for given number of player turns and reports its speed
+/// @details Usage: simulation [turns] [seed]. Should be started from the repository root to find resources.
+/// Uses placeholder textures, so it needs neither display nor OpenGL context.
+/// The player is controlled by RandomPlayerController, the dungeon is regenerated when it dies
+int main(int argc, char* argv[]) {
+    util::LoggerFactory loggerFactory{{std::make_shared<util::ConsoleSink>()}};
+    auto logger = loggerFactory.create("simulation");
+
+    try {
+        std::int64_t turns = argc > 1 ? util::parseUint<std::int64_t>(argv[1]) : defaultTurns;
+        util::SeedT seed = argc > 2 ? util::parseUint<util::SeedT>(argv[2]) : std::random_device{}();
+        util::RandomEngine randomEngine{seed};
+        logger->info("Random seed is {}", seed);
+
+        logger->info("Loading...");
+        auto world = std::make_shared<core::World>(randomEngine);
+        auto raycaster = std::make_shared<util::Raycaster>(world);
+        auto pathfinder = std::make_shared<util::Pathfinder>();
+        auto assets = render::AssetManager::placeholders(loggerFactory, randomEngine);
+        auto particles = std::make_shared<render::ParticleManager>();
+        auto playerMap = std::make_shared<render::PlayerMap>(world, assets);
+        render::Context renderContext{nullptr, playerMap, particles, nullptr, assets};
+
+        auto effects = std::make_shared<core::EffectManager>(assets, loggerFactory);
+        auto spells = std::make_shared<core::SpellManager>(effects, assets, world, particles, playerMap,
+                                                           raycaster, randomEngine, loggerFactory);
+        auto xpManager = std::make_shared<core::XpManager>(world, effects, spells, loggerFactory, randomEngine);
+        auto items = std::make_shared<core::ItemManager>(assets, spells, effects, xpManager, world,
+                                                         randomEngine, loggerFactory);
+        items->load();
+        core::ActorSpawner actorSpawner{world, xpManager, effects, spells, items,
+                                        renderContext, loggerFactory, randomEngine, raycaster, pathfinder};
+
+        generation::DungeonGenerator dungeonGenerator{world, randomEngine};
+        dungeonGenerator.splitChance(0.8);
+        dungeonGenerator.minSize(2);
+
+        world->addChangeListener([raycaster](const core::ChangeJournal& changes) {
+            raycaster->onChanges(changes);
+        });
+        world->addChangeListener([pathfinder](const core::ChangeJournal& changes) {
+            pathfinder->onChanges(changes);
+        });
+        world->addChangeListener([playerMap](const core::ChangeJournal& changes) {
+            playerMap->onChanges(changes);
+        });
+
+        auto generationLogger = loggerFactory.create("generation");
+        auto generate = [&]() {
+            regenerateDungeon(*world, *items, dungeonGenerator, actorSpawner, *generationLogger);
+
+            particles->clear();
+            raycaster->clear();
+            pathfinder->clear();
+            playerMap->onGenerate();
+            xpManager->onGenerate();
+
+            for (const auto& actor : world->actors())
+                if (actor->isOnPlayerSide()) {
+                    actor->controller(std::make_unique<core::RandomPlayerController>(actor, randomEngine));
+                    break;
+                }
+        };
+
+        logger->info("Simulating {} turns...", turns);
+        int generations = 0;
+        std::chrono::steady_clock::duration generationTime{};
+        auto start = std::chrono::steady_clock::now();
+        for (std::int64_t turn = 0; turn < turns; ++turn) {
+            if (turn == 0 || !world->player().isAlive()) {
+                auto generationStart = std::chrono::steady_clock::now();
+                generate();
+                generationTime += std::chrono::steady_clock::now() - generationStart;
+                ++generations;
+            }
+
+            world->update();
+        }
+        std::chrono::duration<double> wallTime = std::chrono::steady_clock::now() - start;
+        std::chrono::duration<double> updateTime = wallTime - generationTime;
+
+        logger->info("Wall time: {:.3f} s ({:.3f} s generating {} dungeons)",
+                     wallTime.count(), std::chrono::duration<double>{generationTime}.count(), generations);
+        logger->info("Turns: {} ({:.1f} turns/s)", turns, turns / updateTime.count());
+        logger->info("Actors processed: {} ({:.1f} actors/s)",
+                     world->processedTurns(), world->processedTurns() / updateTime.count());
+    } catch (const util::TracableException& e) {
+        logger->critical("Error occured: {}\nStacktrace:\n{}",
+                         e.what(), e.stacktrace());
+        return EXIT_FAILURE;
+    } catch (const std::exception& e) {
+        logger->critical("Error occured: {}", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,100 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#ifndef BUCKET_QUEUE_HPP_
+#define BUCKET_QUEUE_HPP_
+
+#include "assert.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace util {
+	/// @brief Dial's bucket queue for values with small nonnegative integer keys
+	/// @details Key is obtained by value.key(). Values with equal keys are popped in LIFO order.
+	/// push is O(1), pop is amortized O(1) when keys grow monotonically like in A* search.
+	/// Pushing a key smaller than the current minimum is allowed but rewinds the scan
+	template <typename T>
+	class BucketQueue {
+	public:
+		[[nodiscard]] bool empty() const noexcept {
+			return size_ == 0;
+		}
+
+		[[nodiscard]] int size() const noexcept {
+			return size_;
+		}
+
+		void push(const T& value) {
+			int key = value.key();
+			TROTE_ASSERT(key >= 0, "BucketQueue supports only nonnegative keys");
+
+			if (key >= std::ssize(heads))
+				heads.resize(key + 1, -1);
+
+			entries.push_back({value, heads[key]});
+			heads[key] = static_cast<int>(entries.size()) - 1;
+
+			if (empty() || key < current)
+				current = key;
+			++size_;
+		}
+
+		template <typename... Args>
+		void emplace(Args&&... args) {
+			push(T(std::forward<Args>(args)...));
+		}
+
+		/// Value with minimal key
+		[[nodiscard]] const T& top() const {
+			TROTE_ASSERT(!empty());
+			return entries[heads[current]].value;
+		}
+
+		void pop() {
+			TROTE_ASSERT(!empty());
+			heads[current] = entries[heads[current]].next;
+			--size_;
+
+			if (empty()) {
+				clear();
+			} else {
+				while (heads[current] < 0)
+					++current;
+			}
+		}
+
+		/// Removes all values keeping allocated memory
+		void clear() noexcept {
+			entries.clear();
+			std::ranges::fill(heads, -1);
+			current = 0;
+			size_ = 0;
+		}
+	private:
+		struct Entry {
+			T value;
+			int next;
+		};
+
+		std::vector<Entry> entries;
+		std::vector<int> heads;
+		int current = 0;
+		int size_ = 0;
+	};
+}
+
+#endif
\ No newline at end of file
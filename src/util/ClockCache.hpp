@@ -0,0 +1,192 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#ifndef CLOCK_CACHE_HPP_
+#define CLOCK_CACHE_HPP_
+
+#include "assert.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace util {
+	/// @brief Fixed capacity map from 64 bit keys to values with CLOCK eviction
+	/// @details Entries live in a preallocated array, an open addressing table with linear probing maps keys to them.
+	/// When the cache is full inserting evicts the first entry not used since the clock hand passed it last time.
+	/// Never allocates after construction
+	template <typename Value>
+	class ClockCache {
+	public:
+		explicit ClockCache(int capacity) :
+				entries(capacity), slots(std::bit_ceil(static_cast<size_t>(capacity) * 2), emptySlot) {
+			TROTE_ASSERT(capacity > 0);
+		}
+
+		/// @brief Finds value for key and marks it as recently used
+		/// @returns nullptr if there is no such key
+		[[nodiscard]] Value* find(std::uint64_t key) noexcept {
+			std::int32_t slot = slots[findSlot(key)];
+			if (slot == emptySlot) {
+				++misses_;
+				return nullptr;
+			}
+
+			++hits_;
+			entries[slot].referenced = true;
+			return &entries[slot].value;
+		}
+
+		/// @brief Inserts value for key evicting some entry if the cache is full
+		/// @warning key shouldn't be in the cache
+		Value& insert(std::uint64_t key, Value value) {
+			Value& inserted = insertRecycled(key);
+			inserted = std::move(value);
+			return inserted;
+		}
+
+		/// @brief Inserts key evicting some entry if the cache is full
+		/// @details Value is left as it was in the reused entry, so callers can reuse its memory.
+		/// It's value initialized only if the entry wasn't used before
+		/// @warning key shouldn't be in the cache
+		Value& insertRecycled(std::uint64_t key) {
+			size_t slot = findSlot(key);
+			TROTE_ASSERT(slots[slot] == emptySlot, "Key is already in the ClockCache");
+
+			std::int32_t entry;
+			if (size_ < capacity()) {
+				entry = size_++;
+			} else {
+				entry = evict();
+				slot = findSlot(key); // eviction may shift slots
+			}
+
+			slots[slot] = entry;
+			entries[entry].key = key;
+			entries[entry].referenced = false;
+			return entries[entry].value;
+		}
+
+		/// @brief Calls f(key, value) for each entry
+		/// @details Doesn't mark entries as recently used
+		template <typename F>
+		void forEach(F&& f) {
+			for (int i = 0; i < size_; ++i)
+				f(entries[i].key, entries[i].value);
+		}
+
+		/// Removes all entries keeping allocated memory
+		void clear() noexcept {
+			std::ranges::fill(slots, emptySlot);
+			size_ = 0;
+			hand = 0;
+		}
+
+		[[nodiscard]] int size() const noexcept {
+			return size_;
+		}
+
+		[[nodiscard]] int capacity() const noexcept {
+			return static_cast<int>(entries.size());
+		}
+
+		[[nodiscard]] ptrdiff_t hits() const noexcept {
+			return hits_;
+		}
+
+		[[nodiscard]] ptrdiff_t misses() const noexcept {
+			return misses_;
+		}
+
+		[[nodiscard]] ptrdiff_t evictions() const noexcept {
+			return evictions_;
+		}
+	private:
+		struct Entry {
+			std::uint64_t key = 0;
+			Value value{};
+			bool referenced = false;
+		};
+
+		static constexpr std::int32_t emptySlot = -1;
+
+		std::vector<Entry> entries;
+		std::vector<std::int32_t> slots;
+		int size_ = 0;
+		int hand = 0;
+
+		ptrdiff_t hits_ = 0;
+		ptrdiff_t misses_ = 0;
+		ptrdiff_t evictions_ = 0;
+
+		[[nodiscard]] size_t mask() const noexcept {
+			return slots.size() - 1;
+		}
+
+		[[nodiscard]] size_t home(std::uint64_t key) const noexcept {
+			// splitmix64 finalizer, packed keys are far from uniform
+			key ^= key >> 30;
+			key *= 0xbf58476d1ce4e5b9ULL;
+			key ^= key >> 27;
+			key *= 0x94d049bb133111ebULL;
+			key ^= key >> 31;
+			return static_cast<size_t>(key) & mask();
+		}
+
+		/// Slot with key or empty slot where key should be inserted
+		[[nodiscard]] size_t findSlot(std::uint64_t key) const noexcept {
+			size_t slot = home(key);
+			while (slots[slot] != emptySlot && entries[slots[slot]].key != key)
+				slot = (slot + 1) & mask();
+			return slot;
+		}
+
+		/// Removes the entry chosen by the clock hand from the table and returns its index
+		std::int32_t evict() noexcept {
+			while (entries[hand].referenced) {
+				entries[hand].referenced = false;
+				hand = (hand + 1) % capacity();
+			}
+
+			std::int32_t victim = hand;
+			hand = (hand + 1) % capacity();
+			eraseSlot(findSlot(entries[victim].key));
+			++evictions_;
+			return victim;
+		}
+
+		/// Backward shift deletion keeping every key reachable from its home slot
+		void eraseSlot(size_t hole) noexcept {
+			size_t slot = hole;
+			while (true) {
+				slot = (slot + 1) & mask();
+				if (slots[slot] == emptySlot)
+					break;
+
+				size_t home_ = home(entries[slots[slot]].key);
+				if (((slot - home_) & mask()) >= ((slot - hole) & mask())) {
+					slots[hole] = slots[slot];
+					hole = slot;
+				}
+			}
+			slots[hole] = emptySlot;
+		}
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,108 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "Connectivity.hpp"
+
+#include "core/World.hpp"
+
+#include "Direction.hpp"
+#include "assert.hpp"
+
+#include <numeric>
+#include <utility>
+
+namespace util {
+	bool Connectivity::connected(const core::World& world, sf::Vector3i position1, sf::Vector3i position2) {
+		TROTE_ASSERT(world.tiles().isValidPosition(position1));
+		TROTE_ASSERT(world.tiles().isValidPosition(position2));
+
+		if (!valid || shape != world.tiles().shape())
+			rebuild(world);
+
+		for (sf::Vector3i position : openedTiles)
+			link(world, position);
+		openedTiles.clear();
+
+		return find(index(position1)) == find(index(position2));
+	}
+
+	void Connectivity::onChanges(const core::ChangeJournal& changes) {
+		if (!valid)
+			return;
+
+		if (changes.allTilesChanged()) {
+			clear();
+			return;
+		}
+
+		for (const core::ChangeJournal::TileChange& change : changes.tiles()) {
+			if (core::isPassable(change.oldTile) && !core::isPassable(change.newTile)) {
+				clear();
+				return;
+			}
+
+			if (!core::isPassable(change.oldTile) && core::isPassable(change.newTile))
+				openedTiles.push_back(change.position);
+		}
+	}
+
+	void Connectivity::rebuild(const core::World& world) {
+		shape = world.tiles().shape();
+		parents.resize(static_cast<size_t>(shape.x) * shape.y * shape.z);
+		std::iota(parents.begin(), parents.end(), 0);
+
+		for (int z = 0; z < shape.z; ++z)
+			for (int y = 0; y < shape.y; ++y)
+				for (int x = 0; x < shape.x; ++x)
+					link(world, {x, y, z});
+
+		valid = true;
+		openedTiles.clear();
+		++rebuilds_;
+	}
+
+	void Connectivity::link(const core::World& world, sf::Vector3i position) {
+		if (!core::isPassable(world.tiles()[position]))
+			return;
+
+		for (sf::Vector2i direction : util::nonzeroDirections<int>) {
+			sf::Vector3i neighbour = position + util::make3D(direction, 0);
+			if (world.tiles().isValidPosition(neighbour) && core::isPassable(world.tiles()[neighbour]))
+				unite(index(position), index(neighbour));
+		}
+
+		if (auto destination = world.stairsDestination(position))
+			unite(index(position), index(*destination));
+	}
+
+	std::int32_t Connectivity::find(std::int32_t index) noexcept {
+		while (parents[index] != index) {
+			parents[index] = parents[parents[index]];
+			index = parents[index];
+		}
+		return index;
+	}
+
+	void Connectivity::unite(std::int32_t index1, std::int32_t index2) noexcept {
+		index1 = find(index1);
+		index2 = find(index2);
+		if (index1 == index2)
+			return;
+
+		if (index1 < index2)
+			std::swap(index1, index2);
+		parents[index1] = index2;
+	}
+}
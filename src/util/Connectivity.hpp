@@ -0,0 +1,73 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#ifndef CONNECTIVITY_HPP_
+#define CONNECTIVITY_HPP_
+
+#include "core/fwd.hpp"
+#include "core/ChangeJournal.hpp"
+
+#include <SFML/System/Vector3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace util {
+	/// @brief Labels of connected components of passable tiles linked by moves and stairs
+	/// @details Union-find over tiles. Opened tiles (e.g. by Dig) are merged incrementally,
+	/// closed tiles and bulk changes make labels rebuilt on the next query.
+	/// Lets path queries between different components fail in O(1) instead of flooding the whole component
+	class Connectivity {
+	public:
+		/// @brief Checks if there may be a path from position1 to position2
+		/// @details Applies changes recorded since the last call first
+		[[nodiscard]] bool connected(const core::World& world, sf::Vector3i position1, sf::Vector3i position2);
+
+		/// Records changes to apply on the next query
+		void onChanges(const core::ChangeJournal& changes);
+
+		/// Makes labels rebuilt on the next query
+		void clear() noexcept {
+			valid = false;
+			openedTiles.clear();
+		}
+
+		/// Number of times labels were rebuilt from scratch
+		[[nodiscard]] ptrdiff_t rebuilds() const noexcept {
+			return rebuilds_;
+		}
+	private:
+		std::vector<std::int32_t> parents;
+		sf::Vector3i shape{0, 0, 0};
+		bool valid = false;
+		ptrdiff_t rebuilds_ = 0;
+
+		std::vector<sf::Vector3i> openedTiles;
+
+		void rebuild(const core::World& world);
+
+		/// Merges passable tile at position with its passable neighbours and stairs destination
+		void link(const core::World& world, sf::Vector3i position);
+
+		[[nodiscard]] std::int32_t find(std::int32_t index) noexcept;
+		void unite(std::int32_t index1, std::int32_t index2) noexcept;
+
+		[[nodiscard]] std::int32_t index(sf::Vector3i position) const noexcept {
+			return position.x + (position.y + position.z * shape.y) * shape.x;
+		}
+	};
+}
+
+#endif
\ No newline at end of file
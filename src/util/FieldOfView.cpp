@@ -0,0 +1,104 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "FieldOfView.hpp"
+
+#include "core/World.hpp"
+
+#include "geometry.hpp"
+#include "assert.hpp"
+
+#include <optional>
+
+namespace util {
+	namespace {
+		/// Division rounding to negative infinity for positive divisor
+		int floorDiv(int dividend, int divisor) noexcept {
+			return dividend / divisor - (dividend % divisor < 0);
+		}
+
+		int ceilDiv(int dividend, int divisor) noexcept {
+			return -floorDiv(-dividend, divisor);
+		}
+	}
+
+	void FieldOfView::compute(const core::World& world, sf::Vector3i origin) {
+		TROTE_ASSERT(world.tiles().isValidPosition(origin));
+
+		origin_ = origin;
+		shape = getXY(world.tiles().shape());
+		bits_.assign((static_cast<size_t>(shape.x) * shape.y + 63) / 64, 0);
+
+		markVisible(origin.x, origin.y);
+		for (int quadrant = 0; quadrant < 4; ++quadrant)
+			scanQuadrant(world, quadrant);
+	}
+
+	void FieldOfView::scanQuadrant(const core::World& world, int quadrant) {
+		auto transform = [this, quadrant](int depth, int column) -> sf::Vector2i {
+			switch (quadrant) {
+			case 0:
+				return {origin_.x + column, origin_.y - depth};
+			case 1:
+				return {origin_.x + column, origin_.y + depth};
+			case 2:
+				return {origin_.x + depth, origin_.y + column};
+			default:
+				return {origin_.x - depth, origin_.y + column};
+			}
+		};
+
+		auto isInside = [this](sf::Vector2i position) {
+			return 0 <= position.x && position.x < shape.x && 0 <= position.y && position.y < shape.y;
+		};
+
+		rows.clear();
+		rows.push_back({1, -1, 1, 1, 1});
+		while (!rows.empty()) {
+			Row row = rows.back();
+			rows.pop_back();
+
+			// depth * slope rounded with ties towards the middle of the row
+			int minColumn = floorDiv(2 * row.depth * row.startNumerator + row.startDenominator, 2 * row.startDenominator);
+			int maxColumn = ceilDiv(2 * row.depth * row.endNumerator - row.endDenominator, 2 * row.endDenominator);
+
+			std::optional<bool> wasWall;
+			for (int column = minColumn; column <= maxColumn; ++column) {
+				sf::Vector2i position = transform(row.depth, column);
+				bool inside = isInside(position);
+				bool isWall = !inside || !core::isPassable(world.tiles()[make3D(position, origin_.z)]);
+
+				bool isSymmetric = column * row.startDenominator >= row.depth * row.startNumerator
+				                && column * row.endDenominator <= row.depth * row.endNumerator;
+				if (inside && (isWall || isSymmetric))
+					markVisible(position.x, position.y);
+
+				if (wasWall == true && !isWall) {
+					row.startNumerator = 2 * column - 1;
+					row.startDenominator = 2 * row.depth;
+				}
+
+				if (wasWall == false && isWall)
+					rows.push_back({row.depth + 1, row.startNumerator, row.startDenominator, 2 * column - 1, 2 * row.depth});
+
+				wasWall = isWall;
+			}
+
+			if (wasWall == false)
+				rows.push_back({row.depth + 1, row.startNumerator, row.startDenominator,
+				                row.endNumerator, row.endDenominator});
+		}
+	}
+}
@@ -0,0 +1,83 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#ifndef FIELD_OF_VIEW_HPP_
+#define FIELD_OF_VIEW_HPP_
+
+#include "core/fwd.hpp"
+
+#include <SFML/System/Vector2.hpp>
+#include <SFML/System/Vector3.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace util {
+	/// @brief Tiles visible from one origin computed by symmetric recursive shadowcasting
+	/// @details Whole level is swept once per compute, octant by octant.
+	/// Floor tiles are visible iff the origin is visible from them. Result is a bitset covering origin level
+	class FieldOfView {
+	public:
+		/// Computes tiles visible from origin on its level
+		void compute(const core::World& world, sf::Vector3i origin);
+
+		/// Checks if position was visible from origin. Positions on other levels are never visible
+		[[nodiscard]] bool isVisible(sf::Vector3i position) const noexcept {
+			if (position.z != origin_.z || position.x < 0 || position.x >= shape.x
+			 || position.y < 0 || position.y >= shape.y)
+				return false;
+
+			auto index = bitIndex(position.x, position.y);
+			return (bits_[index / 64] >> (index % 64)) & 1;
+		}
+
+		[[nodiscard]] sf::Vector3i origin() const noexcept {
+			return origin_;
+		}
+
+		/// Visibility of origin level tiles packed row by row
+		[[nodiscard]] std::span<const std::uint64_t> bits() const noexcept {
+			return bits_;
+		}
+	private:
+		std::vector<std::uint64_t> bits_;
+		sf::Vector3i origin_{0, 0, -1};
+		sf::Vector2i shape{0, 0};
+
+		/// Row of an octant between two slopes stored as fractions with positive denominators
+		struct Row {
+			int depth;
+			int startNumerator;
+			int startDenominator;
+			int endNumerator;
+			int endDenominator;
+		};
+		std::vector<Row> rows;
+
+		[[nodiscard]] ptrdiff_t bitIndex(int x, int y) const noexcept {
+			return static_cast<ptrdiff_t>(y) * shape.x + x;
+		}
+
+		void markVisible(int x, int y) noexcept {
+			auto index = bitIndex(x, y);
+			bits_[index / 64] |= std::uint64_t{1} << (index % 64);
+		}
+
+		void scanQuadrant(const core::World& world, int quadrant);
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,181 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#ifndef INDEXED_HEAP_HPP_
+#define INDEXED_HEAP_HPP_
+
+#include "assert.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace util {
+	/// @brief D-ary min heap of (key, id) pairs with position index
+	/// @details ids are small nonnegative integers (e.g. indices in some array).
+	/// Supports O(log n) update and erase of arbitrary id
+	template <typename Key, int arity = 4>
+	class IndexedHeap {
+	public:
+		[[nodiscard]] bool empty() const noexcept {
+			return entries.empty();
+		}
+
+		[[nodiscard]] int size() const noexcept {
+			return static_cast<int>(entries.size());
+		}
+
+		[[nodiscard]] bool contains(int id) const noexcept {
+			return 0 <= id && id < std::ssize(positions) && positions[id] >= 0;
+		}
+
+		/// Id with minimal key
+		[[nodiscard]] int top() const {
+			TROTE_ASSERT(!empty());
+			return entries.front().id;
+		}
+
+		/// Minimal key
+		[[nodiscard]] const Key& topKey() const {
+			TROTE_ASSERT(!empty());
+			return entries.front().key;
+		}
+
+		[[nodiscard]] const Key& key(int id) const {
+			TROTE_ASSERT(contains(id));
+			return entries[positions[id]].key;
+		}
+
+		/// @warning id shouldn't be in the heap
+		void push(int id, Key key) {
+			TROTE_ASSERT(id >= 0 && !contains(id));
+			if (id >= std::ssize(positions))
+				positions.resize(id + 1, -1);
+
+			entries.push_back({std::move(key), id});
+			positions[id] = size() - 1;
+			siftUp(size() - 1);
+		}
+
+		void pop() {
+			erase(top());
+		}
+
+		/// Changes key of id in the heap. Works both for decrease and increase
+		void update(int id, Key key) {
+			TROTE_ASSERT(contains(id));
+			int position = positions[id];
+			bool decreased = key < entries[position].key;
+			entries[position].key = std::move(key);
+
+			if (decreased)
+				siftUp(position);
+			else
+				siftDown(position);
+		}
+
+		void erase(int id) {
+			TROTE_ASSERT(contains(id));
+			int position = positions[id];
+			positions[id] = -1;
+
+			if (position == size() - 1) {
+				entries.pop_back();
+				return;
+			}
+
+			bool decreased = entries.back().key < entries[position].key;
+			place(position, std::move(entries.back()));
+			entries.pop_back();
+
+			if (decreased)
+				siftUp(position);
+			else
+				siftDown(position);
+		}
+
+		/// @brief Replaces oldId with newId keeping the key
+		/// @details Used when ids are indices of array compacted by swap and pop.
+		/// Does nothing if oldId isn't in the heap
+		void relabel(int oldId, int newId) {
+			TROTE_ASSERT(!contains(newId));
+			if (!contains(oldId))
+				return;
+
+			if (newId >= std::ssize(positions))
+				positions.resize(newId + 1, -1);
+
+			int position = positions[oldId];
+			positions[oldId] = -1;
+			entries[position].id = newId;
+			positions[newId] = position;
+		}
+
+		void clear() noexcept {
+			entries.clear();
+			positions.clear();
+		}
+	private:
+		struct Entry {
+			Key key;
+			int id;
+		};
+
+		std::vector<Entry> entries;
+		std::vector<int> positions;
+
+		void place(int position, Entry entry) {
+			positions[entry.id] = position;
+			entries[position] = std::move(entry);
+		}
+
+		void siftUp(int position) {
+			Entry entry = std::move(entries[position]);
+			while (position > 0) {
+				int parent = (position - 1) / arity;
+				if (!(entry.key < entries[parent].key))
+					break;
+
+				place(position, std::move(entries[parent]));
+				position = parent;
+			}
+			place(position, std::move(entry));
+		}
+
+		void siftDown(int position) {
+			Entry entry = std::move(entries[position]);
+			while (true) {
+				int firstChild = position * arity + 1;
+				if (firstChild >= size())
+					break;
+
+				int lastChild = std::min(firstChild + arity, size());
+				int minChild = firstChild;
+				for (int child = firstChild + 1; child < lastChild; ++child)
+					if (entries[child].key < entries[minChild].key)
+						minChild = child;
+
+				if (!(entries[minChild].key < entry.key))
+					break;
+
+				place(position, std::move(entries[minChild]));
+				position = minChild;
+			}
+			place(position, std::move(entry));
+		}
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,161 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "StairGraph.hpp"
+
+#include "core/World.hpp"
+
+#include "Direction.hpp"
+#include "Map.hpp"
+#include "assert.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+namespace util {
+	namespace {
+		struct StairUpdate {
+			int distance;
+			sf::Vector3i position;
+			std::optional<sf::Vector3i> firstStairs; ///< First stairs taken on the way, empty until some are taken
+			bool reachedTarget;
+
+			friend auto operator <=> (const StairUpdate& lhs, const StairUpdate& rhs) noexcept {
+				return lhs.distance <=> rhs.distance;
+			}
+
+			friend bool operator == (const StairUpdate& lhs, const StairUpdate& rhs) noexcept {
+				return lhs.distance == rhs.distance;
+			}
+		};
+	}
+
+	std::optional<sf::Vector3i> StairGraph::nextStairs(const core::World& world, sf::Vector3i from, sf::Vector3i to,
+	                                                   const std::function<bool(sf::Vector3i)>& canUse) {
+		TROTE_ASSERT(world.tiles().isValidPosition(from));
+		TROTE_ASSERT(world.tiles().isValidPosition(to));
+		TROTE_ASSERT(from.z != to.z, "StairGraph is only for cross-level queries");
+
+		auto usable = [&canUse](sf::Vector3i stairs) {
+			return !canUse || canUse(stairs);
+		};
+
+		std::priority_queue<StairUpdate, std::vector<StairUpdate>, std::greater<>> queue;
+
+		const Level& fromLevel = level(world, from.z);
+		planarDistances(world, from, sourceDistances);
+		for (sf::Vector3i stairs : fromLevel.stairs)
+			if (std::uint16_t distance = tileDistance(world, sourceDistances, stairs); distance != unreached && usable(stairs))
+				queue.push({distance, stairs, std::nullopt, false});
+
+		planarDistances(world, to, targetDistances);
+
+		UnorderedMap<sf::Vector3i, int> visited;
+		while (!queue.empty()) {
+			StairUpdate update = queue.top();
+			queue.pop();
+
+			if (update.reachedTarget)
+				return *update.firstStairs;
+
+			if (!visited.try_emplace(update.position, update.distance).second)
+				continue;
+
+			if (update.position.z == to.z) {
+				std::uint16_t distance = tileDistance(world, targetDistances, update.position);
+				if (distance != unreached)
+					queue.push({update.distance + distance, update.position, update.firstStairs, true});
+			}
+
+			if (auto destination = world.stairsDestination(update.position))
+				if (!visited.contains(*destination) && usable(*destination))
+					queue.push({update.distance + 1, *destination, update.firstStairs.value_or(update.position), false});
+
+			const Level& level_ = level(world, update.position.z);
+			auto index = std::find(level_.stairs.begin(), level_.stairs.end(), update.position) - level_.stairs.begin();
+			for (ptrdiff_t i = 0; i < std::ssize(level_.stairs); ++i) {
+				std::uint16_t distance = level_.distances[index * std::ssize(level_.stairs) + i];
+				if (i != index && distance != unreached && !visited.contains(level_.stairs[i]) && usable(level_.stairs[i]))
+					queue.push({update.distance + distance, level_.stairs[i], update.firstStairs, false});
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	const StairGraph::Level& StairGraph::level(const core::World& world, int z) {
+		if (std::ssize(levels) != world.tiles().shape().z)
+			levels.assign(world.tiles().shape().z, {});
+
+		Level& level_ = levels[z];
+		if (level_.valid)
+			return level_;
+
+		level_.stairs.clear();
+		for (const auto& stairs : {std::cref(world.upStairs()), std::cref(world.downStairs())})
+			for (const auto& [position, destination] : stairs.get())
+				if (position.z == z)
+					level_.stairs.push_back(position);
+		std::ranges::sort(level_.stairs, [](sf::Vector3i lhs, sf::Vector3i rhs) {
+			return std::tie(lhs.y, lhs.x) < std::tie(rhs.y, rhs.x);
+		});
+
+		auto stairCount = std::ssize(level_.stairs);
+		level_.distances.assign(stairCount * stairCount, unreached);
+		for (ptrdiff_t i = 0; i < stairCount; ++i) {
+			planarDistances(world, level_.stairs[i], stairDistances);
+			for (ptrdiff_t j = 0; j < stairCount; ++j)
+				level_.distances[i * stairCount + j] = tileDistance(world, stairDistances, level_.stairs[j]);
+		}
+
+		level_.valid = true;
+		++levelComputations_;
+		return level_;
+	}
+
+	void StairGraph::planarDistances(const core::World& world, sf::Vector3i source,
+	                                 std::vector<std::uint16_t>& distances) {
+		sf::Vector3i shape = world.tiles().shape();
+		distances.assign(static_cast<size_t>(shape.x) * shape.y, unreached);
+		frontier.clear();
+
+		distances[source.x + source.y * shape.x] = 0;
+		frontier.push_back(source);
+		for (size_t i = 0; i < frontier.size(); ++i) {
+			sf::Vector3i position = frontier[i];
+			int nextDistance = distances[position.x + position.y * shape.x] + 1;
+			TROTE_ASSERT(nextDistance < unreached, "level is too large for packed distances");
+
+			for (sf::Vector2i direction : util::nonzeroDirections<int>) {
+				sf::Vector3i nextPos = position + util::make3D(direction, 0);
+				if (!world.tiles().isValidPosition(nextPos) || !core::isPassable(world.tiles()[nextPos]))
+					continue;
+
+				std::uint16_t& distance = distances[nextPos.x + nextPos.y * shape.x];
+				if (distance != unreached)
+					continue;
+
+				distance = static_cast<std::uint16_t>(nextDistance);
+				frontier.push_back(nextPos);
+			}
+		}
+	}
+
+	std::uint16_t StairGraph::tileDistance(const core::World& world, const std::vector<std::uint16_t>& distances,
+	                                       sf::Vector3i position) {
+		return distances[position.x + position.y * world.tiles().shape().x];
+	}
+}
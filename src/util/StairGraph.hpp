@@ -0,0 +1,92 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#ifndef STAIR_GRAPH_HPP_
+#define STAIR_GRAPH_HPP_
+
+#include "core/fwd.hpp"
+
+#include <SFML/System/Vector3.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace util {
+	/// @brief Abstract graph of stairs for hierarchical (HPA*) cross-level pathfinding
+	/// @details Nodes are stairs tiles. Stairs are linked to their destination with cost 1
+	/// and to other stairs on the same level with distance inside the level.
+	/// Edges of a level are computed when the search first reaches it and invalidated only if that level is changed,
+	/// so cost of a query depends on the levels between its ends, not on dungeon depth
+	class StairGraph {
+	public:
+		inline const static std::uint16_t unreached = 65535;
+
+		/// @brief Finds stairs on from level which should be taken first to reach to
+		/// @details to should be on another level.
+		/// If canUse is given stairs for which it returns false aren't taken and aren't entered from other stairs,
+		/// so routes never lead through stairs forbidden by the caller (e. g. unseen by the player)
+		/// @returns std::nullopt if to is unreachable
+		std::optional<sf::Vector3i> nextStairs(const core::World& world, sf::Vector3i from, sf::Vector3i to,
+		                                       const std::function<bool(sf::Vector3i)>& canUse = {});
+
+		/// Drops edges of level so they are recomputed on the next use
+		void invalidate(int level) noexcept {
+			if (0 <= level && level < std::ssize(levels))
+				levels[level].valid = false;
+		}
+
+		/// Drops all edges. Should be called if stairs are changed
+		void clear() noexcept {
+			levels.clear();
+		}
+
+		/// Number of times edges of some level were computed
+		[[nodiscard]] ptrdiff_t levelComputations() const noexcept {
+			return levelComputations_;
+		}
+	private:
+		struct Level {
+			std::vector<sf::Vector3i> stairs;
+
+			/// Distance between stairs i and j is stored at i * stairs.size() + j
+			std::vector<std::uint16_t> distances;
+
+			bool valid = false;
+		};
+
+		std::vector<Level> levels;
+		ptrdiff_t levelComputations_ = 0;
+
+		/// Scratch distances to every tile of a level reused between queries
+		std::vector<std::uint16_t> sourceDistances;
+		std::vector<std::uint16_t> targetDistances;
+		std::vector<std::uint16_t> stairDistances;
+		std::vector<sf::Vector3i> frontier;
+
+		/// Computes edges of level if they aren't valid
+		const Level& level(const core::World& world, int z);
+
+		/// Fills distances with distances from source staying on its level
+		void planarDistances(const core::World& world, sf::Vector3i source, std::vector<std::uint16_t>& distances);
+
+		[[nodiscard]] static std::uint16_t tileDistance(const core::World& world,
+		                                                const std::vector<std::uint16_t>& distances,
+		                                                sf::Vector3i position);
+	};
+}
+
+#endif
\ No newline at end of file
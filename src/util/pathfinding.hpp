@@ -20,49 +20,259 @@ If not, see <https://www.gnu.org/licenses/>. */
 #include "core/World.hpp"
 
 #include "Array3D.hpp"
+#include "BucketQueue.hpp"
+#include "Connectivity.hpp"
 #include "Direction.hpp"
+#include "StairGraph.hpp"
 #include "assert.hpp"
 
 #include <SFML/System/Vector3.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <optional>
 #include <queue>
+#include <span>
+#include <vector>
 
 namespace util {
+	/// @brief Scratch nodes of a path search reused between searches
+	/// @details Each Node stores stamp of the search that initialized it.
+	/// Node with old stamp is treated as untouched so reset is O(1) and search cost doesn't depend on dungeon volume.
+	/// Covers the whole dungeon so it's shared through Pathfinder instead of being owned by every actor
 	struct PathBuffer {
+		/// @brief Packed search node
+		/// @details Previous step is stored as index in util::directions or as a stair flag.
+		/// Stairs are symmetric so previous position of a node reached by stairs is looked up in World stair table
 		struct Node {
-			int distance = std::numeric_limits<int>::max();
-			sf::Vector3i prevOffset{0, 0, 0};
-			bool onPath = false;
+			inline const static std::uint16_t unreached = std::numeric_limits<std::uint16_t>::max();
+
+			/// Flag in prevStep meaning that node was reached by stairs
+			inline const static std::uint8_t stairsStep = 0x10;
+
+			/// prevStep of the search start
+			inline const static std::uint8_t noStep = 4;
+
+			std::uint16_t distance = unreached;
+			std::uint16_t stamp = 0;
+			std::uint8_t prevStep = noStep;
 		};
 
 		util::Array3D<Node> buffer;
-		std::optional<sf::Vector3i> lastTarget;
+		std::uint16_t currentStamp = 0;
+
+		/// Encodes planar offset to the previous node as its index in util::directions
+		[[nodiscard]] static std::uint8_t encodeStep(sf::Vector2i offset) noexcept {
+			return static_cast<std::uint8_t>((offset.x + 1) + (1 - offset.y) * 3);
+		}
+
+		/// Applies encoded step to position
+		[[nodiscard]] static sf::Vector3i applyStep(const core::World& world, sf::Vector3i position, std::uint8_t step) {
+			if (step & Node::stairsStep)
+				return *world.stairsDestination(position);
+			return position + util::make3D(util::directions<int>[step], 0);
+		}
+
+		/// @brief Starts new search invalidating all nodes
+		/// @details Clears buffer only if shape changed or stamp overflowed
+		void reset(sf::Vector3i shape) {
+			if (buffer.shape() != shape || currentStamp == std::numeric_limits<std::uint16_t>::max()) {
+				buffer.assign(shape, {});
+				currentStamp = 0;
+			}
+			++currentStamp;
+		}
+
+		/// Gets node initializing it if it wasn't touched since last reset
+		[[nodiscard]] Node& operator[] (sf::Vector3i position) {
+			Node& node = buffer[position];
+			if (node.stamp != currentStamp) {
+				node = {};
+				node.stamp = currentStamp;
+			}
+			return node;
+		}
+	};
+
+	/// @brief Path cached by an actor between turns
+	/// @details Much smaller than PathBuffer because it stores only the steps of the found path
+	struct CachedPath {
+		/// Positions from the target (front) to the actor position (back)
+		std::vector<sf::Vector3i> steps;
+		std::optional<sf::Vector3i> target;
+
+		/// Steps end at intermediate stairs destination instead of target and should be extended there
+		bool partial = false;
+
+		/// Number of times target was moved next to the end of the path or path was repaired since the last search
+		int extensions = 0;
+
+		/// Version of Pathfinder tiles the steps were checked against
+		std::uint32_t tilesVersion = 0;
+
+		/// Each extension or repair may make path at most 2 steps longer than the shortest one
+		inline const static int maxExtensions = 2;
+
+		/// @brief Drops steps already passed by the actor
+		/// @returns false if position isn't on the path so it should be recomputed
+		bool advanceTo(sf::Vector3i position) {
+			auto iter = std::find(steps.rbegin(), steps.rend(), position);
+			if (iter == steps.rend())
+				return false;
+
+			steps.erase(iter.base(), steps.end());
+			return true;
+		}
+
+		/// @brief Moves target to newTarget reusing already found steps
+		/// @details Target moved onto the path cuts it. Target moved next to its end adds one step,
+		/// at most maxExtensions times in a row so the path stays nearly shortest.
+		/// Only the steps are kept between calls, not search state as in LPA* or D* Lite,
+		/// so any other move of the target needs a new search
+		/// @returns false if path should be recomputed
+		template <typename IsPassable>
+		bool retarget(const core::World& world, sf::Vector3i newTarget, const IsPassable& isPassable) {
+			if (!target || partial || steps.empty() || steps.front() != *target)
+				return false;
+
+			if (auto iter = std::find(steps.begin(), steps.end(), newTarget); iter != steps.end()) {
+				steps.erase(steps.begin(), iter);
+				target = newTarget;
+				return true;
+			}
+
+			if (extensions >= maxExtensions || !isPassable(world, newTarget))
+				return false;
+
+			sf::Vector3i offset = newTarget - steps.front();
+			if ((offset.z != 0 || util::uniformNorm(util::getXY(offset)) > 1)
+			 && world.stairsDestination(steps.front()) != newTarget)
+				return false;
+
+			steps.insert(steps.begin(), newTarget);
+			target = newTarget;
+			++extensions;
+			return true;
+		}
+
+		/// Stores that target can't be reached from position
+		void markUnreachable(sf::Vector3i position, sf::Vector3i target_) {
+			steps.assign(1, position);
+			target = target_;
+			partial = false;
+			extensions = 0;
+		}
+
+		/// Offset to the next step. Zero if target is reached or unreachable
+		[[nodiscard]] sf::Vector3i nextOffset() const noexcept {
+			if (steps.size() < 2)
+				return {0, 0, 0};
+			return steps[steps.size() - 2] - steps.back();
+		}
+	};
+
+	/// @brief Lower bound of path length to target used by path searches
+	/// @details Distance between x and y isn't a lower bound once stairs lead to other x and y,
+	/// even path to the same level may go through other levels.
+	/// Such path walks to some stairs on its level first and from some stairs on the target level last
+	class PathEstimate {
+	public:
+		PathEstimate(const core::World& world, sf::Vector3i target_) : target{target_} {
+			levelBegins.assign(std::max(world.tiles().shape().z, 0) + 1, 0);
+			for (const auto* stairsMap : {&world.upStairs(), &world.downStairs()})
+				for (const auto& [position, destination] : *stairsMap)
+					++levelBegins[position.z + 1];
+			for (int z = 1; z < std::ssize(levelBegins); ++z)
+				levelBegins[z] += levelBegins[z - 1];
+
+			stairs.resize(levelBegins.back());
+			std::vector<int> ends(levelBegins.begin(), levelBegins.end() - 1);
+			for (const auto* stairsMap : {&world.upStairs(), &world.downStairs()})
+				for (const auto& [position, destination] : *stairsMap)
+					stairs[ends[position.z]++] = getXY(position);
+
+			fromTargetStairs = toStairs(target);
+		}
+
+		/// Minimal number of steps from position to target
+		[[nodiscard]] int operator() (sf::Vector3i position) const noexcept {
+			int direct = position.z == target.z ? uniformDistance(getXY(position), getXY(target)) : noPath;
+			if (fromTargetStairs == noPath)
+				return direct == noPath ? 0 : direct;
+
+			// at least one stairs step to another level, two to return to the same one
+			int stairsSteps = position.z == target.z ? 2 : 1;
+			if (direct <= stairsSteps + fromTargetStairs)
+				return direct;
+
+			int viaStairs = toStairs(position);
+			if (viaStairs == noPath)
+				return direct == noPath ? 0 : direct;
+			return std::min(direct, viaStairs + stairsSteps + fromTargetStairs);
+		}
+	private:
+		static constexpr int noPath = std::numeric_limits<int>::max() / 2;
+
+		sf::Vector3i target;
+		/// Stairs positions sorted by level, stairs on level z start at levelBegins[z]
+		std::vector<sf::Vector2i> stairs;
+		std::vector<int> levelBegins;
+		int fromTargetStairs;
+
+		/// Distance between position and the nearest stairs on its level ignoring walls
+		[[nodiscard]] int toStairs(sf::Vector3i position) const noexcept {
+			int result = noPath;
+			for (int i = levelBegins[position.z]; i < levelBegins[position.z + 1]; ++i)
+				result = std::min(result, uniformDistance(stairs[i], getXY(position)));
+			return result;
+		}
 	};
 
 	struct PathUpdate {
-		PathUpdate(int distance_, sf::Vector3i position_, sf::Vector3i target, sf::Vector3i prevOffset_) noexcept :
-			distance{distance_}, minFullDistance{distance_ + util::uniformDistance(position_, target)},
-			position{position_}, prevOffset{prevOffset_} {}
+		PathUpdate(int distance_, sf::Vector3i position_, const PathEstimate& estimate, std::uint8_t prevStep_) noexcept :
+			distance{distance_}, minFullDistance{distance_ + estimate(position_)},
+			position{position_}, prevStep{prevStep_} {}
 
 		int distance;
 		int minFullDistance;
 		sf::Vector3i position;
-		sf::Vector3i prevOffset;
+		std::uint8_t prevStep;
+
+		/// Priority used by BucketQueue
+		[[nodiscard]] int key() const noexcept {
+			return minFullDistance;
+		}
 
 		friend auto operator <=> (const PathUpdate& lhs, const PathUpdate& rhs) noexcept {
 			return lhs.minFullDistance <=> rhs.minFullDistance;
 		}
 	};
 
-	template <typename IsPassable>
+	/// Search frontier policy using binary heap
+	struct HeapFrontier {
+		template <typename Update>
+		using Queue = std::priority_queue<Update, std::vector<Update>, std::greater<>>;
+	};
+
+	/// @brief Search frontier policy using Dial's bucket queue
+	/// @details All edge costs are 1 so priorities are small integers and buckets beat the heap
+	struct BucketFrontier {
+		template <typename Update>
+		using Queue = BucketQueue<Update>;
+	};
+
+	/// @tparam Frontier Policy choosing priority queue (HeapFrontier or BucketFrontier)
+	template <typename Frontier = BucketFrontier, typename IsPassable>
 		requires std::convertible_to<std::invoke_result_t<IsPassable, const core::World&, sf::Vector3i>, bool>
 	void findPath(const core::World& world, sf::Vector3i from, sf::Vector3i to, 
-				  util::Array3D<PathBuffer::Node>& buffer, const IsPassable& isPassable) {
-		buffer.assign(world.tiles().shape(), {});
+				  PathBuffer& buffer, const IsPassable& isPassable) {
+		buffer.reset(world.tiles().shape());
 
-		std::priority_queue<PathUpdate, std::vector<PathUpdate>, std::greater<>> queue;
-		queue.emplace(0, from, to, sf::Vector3i{0, 0, 0});
+		PathEstimate estimate{world, to};
+		typename Frontier::template Queue<PathUpdate> queue;
+		queue.emplace(0, from, estimate, PathBuffer::Node::noStep);
 
 		while (!queue.empty()) {
 			PathUpdate update = queue.top();
@@ -73,79 +283,232 @@ namespace util {
 			if (update.minFullDistance >= buffer[to].distance)
 				break;
 
-			if (update.distance >= buffer[update.position].distance)
+			PathBuffer::Node& node = buffer[update.position];
+			if (update.distance >= node.distance)
 				continue;
 
-			buffer[update.position].distance = update.distance;
-			buffer[update.position].prevOffset = update.prevOffset;
+			TROTE_ASSERT(update.distance < PathBuffer::Node::unreached, "path is too long for packed node");
+			node.distance = static_cast<std::uint16_t>(update.distance);
+			node.prevStep = update.prevStep;
 
 			for (sf::Vector2i direction : util::nonzeroDirections<int>) {
 				sf::Vector3i direction3D = util::make3D(direction, 0);
 				sf::Vector3i nextPos = update.position + direction3D;
 				if (world.tiles().isValidPosition(nextPos) && isPassable(world, nextPos)) 
-					queue.emplace(update.distance + 1, nextPos, to, -direction3D);
+					queue.emplace(update.distance + 1, nextPos, estimate, PathBuffer::encodeStep(-direction));
 			}
 
-			if (auto destination = world.upStairs(update.position))
-				queue.emplace(update.distance + 1, *destination, to, update.position - *destination);
-
-			if (auto destination = world.downStairs(update.position))
-				queue.emplace(update.distance + 1, *destination, to, update.position - *destination);
+			if (auto destination = world.stairsDestination(update.position))
+				queue.emplace(update.distance + 1, *destination, estimate, PathBuffer::Node::stairsStep);
 		}
 	}
 
-	/// @brief Computes next move to perform to move from position to target
-	/// @param buffer Buffer reused to prevent allocating memory
-	template <typename IsPassable>
+	/// @brief Jump Point Search variant of findPath
+	/// @details Expands only jump points: tiles with forced neighbours, stairs and the target.
+	/// Stairs are handled as special successors like in findPath.
+	/// Tiles between jump points aren't stored, tracePath restores them.
+	/// Diagonal moves cost the same as straight ones but pruning rules stay valid so found paths are still shortest
+	/// @tparam Frontier Policy choosing priority queue (HeapFrontier or BucketFrontier)
+	template <typename Frontier = BucketFrontier, typename IsPassable>
 		requires std::convertible_to<std::invoke_result_t<IsPassable, const core::World&, sf::Vector3i>, bool>
-	sf::Vector3i nextStep(const core::World& world, sf::Vector3i position, sf::Vector3i target,
-						  PathBuffer& buffer, const IsPassable& isPassable) {
-		TROTE_ASSERT(world.tiles().isValidPosition(position));
-		TROTE_ASSERT(world.tiles().isValidPosition(target));
+	void findJumpPointPath(const core::World& world, sf::Vector3i from, sf::Vector3i to,
+	                       PathBuffer& buffer, const IsPassable& isPassable) {
+		buffer.reset(world.tiles().shape());
+
+		auto isFree = [&](sf::Vector3i position) {
+			return world.tiles().isValidPosition(position) && isPassable(world, position);
+		};
+
+		auto isForced = [&](sf::Vector3i position, sf::Vector2i side, sf::Vector2i direction) {
+			return !isFree(position + util::make3D(side, 0)) && isFree(position + util::make3D(direction + side, 0));
+		};
+
+		auto hasForcedNeighbor = [&](sf::Vector3i position, sf::Vector2i direction) {
+			if (direction.x != 0 && direction.y != 0)
+				return isForced(position, {-direction.x, 0}, {0, direction.y})
+				    || isForced(position, {0, -direction.y}, {direction.x, 0});
+
+			sf::Vector2i side = util::turn90Left(direction);
+			return isForced(position, side, direction) || isForced(position, -side, direction);
+		};
+
+		auto isJumpPoint = [&](sf::Vector3i position, sf::Vector2i direction) {
+			return position == to || world.stairsDestination(position) || hasForcedNeighbor(position, direction);
+		};
+
+		// Both return number of steps to the next jump point or 0 if there is none
+		auto jumpStraight = [&](sf::Vector3i position, sf::Vector2i direction) {
+			for (int steps = 1; ; ++steps) {
+				position += util::make3D(direction, 0);
+				if (!isFree(position))
+					return 0;
+				if (isJumpPoint(position, direction))
+					return steps;
+			}
+		};
+
+		auto jump = [&](sf::Vector3i position, sf::Vector2i direction) {
+			if (direction.x == 0 || direction.y == 0)
+				return jumpStraight(position, direction);
+
+			for (int steps = 1; ; ++steps) {
+				position += util::make3D(direction, 0);
+				if (!isFree(position))
+					return 0;
+				if (isJumpPoint(position, direction)
+				 || jumpStraight(position, {direction.x, 0}) || jumpStraight(position, {0, direction.y}))
+					return steps;
+			}
+		};
+
+		PathEstimate estimate{world, to};
+		typename Frontier::template Queue<PathUpdate> queue;
+		queue.emplace(0, from, estimate, PathBuffer::Node::noStep);
+
+		while (!queue.empty()) {
+			PathUpdate update = queue.top();
+			queue.pop();
+
+			TROTE_ASSERT(world.tiles().isValidPosition(update.position));
+
+			if (update.minFullDistance >= buffer[to].distance)
+				break;
 
-		if (!buffer.lastTarget || *buffer.lastTarget != target || !buffer.buffer[position].onPath) {
-			findPath(world, position, target, buffer.buffer, isPassable);
-			buffer.lastTarget = target;
+			PathBuffer::Node& node = buffer[update.position];
+			if (update.distance >= node.distance)
+				continue;
+
+			TROTE_ASSERT(update.distance < PathBuffer::Node::unreached, "path is too long for packed node");
+			node.distance = static_cast<std::uint16_t>(update.distance);
+			node.prevStep = update.prevStep;
+
+			auto tryJump = [&](sf::Vector2i direction) {
+				if (int steps = jump(update.position, direction))
+					queue.emplace(update.distance + steps, update.position + util::make3D(direction * steps, 0),
+					              estimate, PathBuffer::encodeStep(-direction));
+			};
+
+			if (update.prevStep == PathBuffer::Node::noStep || (update.prevStep & PathBuffer::Node::stairsStep)) {
+				for (sf::Vector2i direction : util::nonzeroDirections<int>)
+					tryJump(direction);
+			} else {
+				sf::Vector2i direction = -util::directions<int>[update.prevStep];
+				tryJump(direction);
+				if (direction.x != 0 && direction.y != 0) {
+					tryJump({direction.x, 0});
+					tryJump({0, direction.y});
+					if (!isFree(update.position - sf::Vector3i{direction.x, 0, 0}))
+						tryJump({-direction.x, direction.y});
+					if (!isFree(update.position - sf::Vector3i{0, direction.y, 0}))
+						tryJump({direction.x, -direction.y});
+				} else {
+					sf::Vector2i side = util::turn90Left(direction);
+					if (!isFree(update.position + util::make3D(side, 0)))
+						tryJump(direction + side);
+					if (!isFree(update.position - util::make3D(side, 0)))
+						tryJump(direction - side);
+				}
+			}
+
+			if (auto destination = world.stairsDestination(update.position))
+				queue.emplace(update.distance + 1, *destination, estimate, PathBuffer::Node::stairsStep);
 		}
+	}
 
-		buffer.buffer[position].onPath = true;
+	/// Path search policy expanding every reachable tile with findPath
+	struct AStarSearch {
+		template <typename IsPassable>
+		static void findPath(const core::World& world, sf::Vector3i from, sf::Vector3i to,
+		                     PathBuffer& buffer, const IsPassable& isPassable) {
+			util::findPath(world, from, to, buffer, isPassable);
+		}
+	};
 
-		sf::Vector3i current = target;
-		while (true) {
-			buffer.buffer[current].onPath = true;
+	/// Path search policy expanding only jump points with findJumpPointPath
+	struct JumpPointSearch {
+		template <typename IsPassable>
+		static void findPath(const core::World& world, sf::Vector3i from, sf::Vector3i to,
+		                     PathBuffer& buffer, const IsPassable& isPassable) {
+			util::findJumpPointPath(world, from, to, buffer, isPassable);
+		}
+	};
 
-			sf::Vector3i prevOffset = buffer.buffer[current].prevOffset;
+	/// @brief Stores path from from to to found by the last search in path
+	/// @details Stores only from if to wasn't reached.
+	/// Jump point search leaves tiles between jump points untouched so their step is taken from the last reached node.
+	/// Reached node with distance not greater than expected always continues some shortest path
+	inline void tracePath(const core::World& world, PathBuffer& buffer, sf::Vector3i from, sf::Vector3i to,
+		                  CachedPath& path) {
+		path.steps.clear();
+		path.partial = false;
+		path.extensions = 0;
+		if (buffer[to].distance == PathBuffer::Node::unreached) {
+			path.steps.push_back(from);
+			return;
+		}
 
-			if (current + prevOffset == position)
-				return -buffer.buffer[current].prevOffset;
+		int distance = buffer[to].distance;
+		std::uint8_t step = PathBuffer::Node::noStep;
+		for (sf::Vector3i current = to; ; current = PathBuffer::applyStep(world, current, step), --distance) {
+			path.steps.push_back(current);
+			if (current == from)
+				return;
 
-			if (prevOffset == sf::Vector3i{0, 0, 0})
-				return {0, 0, 0};
+			if (const PathBuffer::Node& node = buffer[current]; node.distance <= distance) {
+				distance = node.distance;
+				step = node.prevStep;
+			}
+			TROTE_ASSERT(distance > 0 && step != PathBuffer::Node::noStep, "broken path");
+		}
+	}
 
-			current += prevOffset;
+	/// @brief Computes next move to perform to move from position to target
+	/// @details Reuses path cached from the last call if position is still on path.
+	/// If target moved the cached path is repaired with CachedPath::retarget when possible
+	/// @param buffer Scratch buffer used if path should be recomputed
+	/// @tparam Search Policy choosing search algorithm (AStarSearch or JumpPointSearch)
+	template <typename Search = JumpPointSearch, typename IsPassable>
+		requires std::convertible_to<std::invoke_result_t<IsPassable, const core::World&, sf::Vector3i>, bool>
+	sf::Vector3i nextStep(const core::World& world, sf::Vector3i position, sf::Vector3i target,
+						  CachedPath& path, PathBuffer& buffer, const IsPassable& isPassable) {
+		TROTE_ASSERT(world.tiles().isValidPosition(position));
+		TROTE_ASSERT(world.tiles().isValidPosition(target));
+
+		bool reusable = !path.partial && path.advanceTo(position)
+		             && (path.target == target || path.retarget(world, target, isPassable));
+		if (!reusable) {
+			Search::findPath(world, position, target, buffer, isPassable);
+			tracePath(world, buffer, position, target, path);
+			path.target = target;
 		}
 
-		TROTE_ASSERT(false, "unreachable");
+		return path.nextOffset();
 	}
 
-	template <typename IsPassable>
+	template <typename Search = JumpPointSearch, typename IsPassable>
 		requires std::convertible_to<std::invoke_result_t<IsPassable, core::Tile>, bool>
 	sf::Vector3i nextStep(const core::World& world, sf::Vector3i position, sf::Vector3i target,
-		                  PathBuffer& buffer, const IsPassable& isPassable) {
-		return nextStep(world, position, target, buffer, [&](const core::World& world, sf::Vector3i pos) {
+		                  CachedPath& path, PathBuffer& buffer, const IsPassable& isPassable) {
+		return nextStep<Search>(world, position, target, path, buffer, [&](const core::World& world, sf::Vector3i pos) {
 			return isPassable(world.tiles()[pos]);
 		});
 	}
 
-	inline sf::Vector3i nextStep(const core::World& world, sf::Vector3i position, sf::Vector3i target,
-		                  PathBuffer& buffer) {
-		return nextStep(world, position, target, buffer, &core::isPassable);
+	template <typename Search = JumpPointSearch>
+	sf::Vector3i nextStep(const core::World& world, sf::Vector3i position, sf::Vector3i target,
+		                  CachedPath& path, PathBuffer& buffer) {
+		return nextStep<Search>(world, position, target, path, buffer, &core::isPassable);
 	}
 
 	struct ExplorePathUpdate {
 		int distance;
 		sf::Vector3i position;
-		sf::Vector3i prevOffset;
+		std::uint8_t prevStep;
+
+		/// Priority used by BucketQueue
+		[[nodiscard]] int key() const noexcept {
+			return distance;
+		}
 
 		friend auto operator <=> (const ExplorePathUpdate& lhs, const ExplorePathUpdate& rhs) noexcept {
 			return lhs.distance <=> rhs.distance;
@@ -154,14 +517,15 @@ namespace util {
 
 	/// @brief finds path (may be not shortest) to a tile satisfying isTarget
 	/// @returns lastTarget to found target position
-	template <typename IsTarget>
+	/// @tparam Frontier Policy choosing priority queue (HeapFrontier or BucketFrontier)
+	template <typename Frontier = BucketFrontier, typename IsTarget>
 		requires std::convertible_to<std::invoke_result_t<IsTarget, const core::World&, sf::Vector3i>, bool>
 	std::optional<sf::Vector3i> findExplorePath(const core::World& world, sf::Vector3i from, 
-		             util::Array3D<PathBuffer::Node>& buffer, const IsTarget& isTarget) {
-		buffer.assign(world.tiles().shape(), {});
+		             PathBuffer& buffer, const IsTarget& isTarget) {
+		buffer.reset(world.tiles().shape());
 
-		std::priority_queue<ExplorePathUpdate, std::vector<ExplorePathUpdate>, std::greater<>> queue;
-		queue.emplace(0, from, sf::Vector3i{0, 0, 0});
+		typename Frontier::template Queue<ExplorePathUpdate> queue;
+		queue.emplace(0, from, PathBuffer::Node::noStep);
 
 		while (!queue.empty()) {
 			ExplorePathUpdate update = queue.top();
@@ -169,11 +533,13 @@ namespace util {
 
 			TROTE_ASSERT(world.tiles().isValidPosition(update.position));
 
-			if (update.distance >= buffer[update.position].distance)
+			PathBuffer::Node& node = buffer[update.position];
+			if (update.distance >= node.distance)
 				continue;
 
-			buffer[update.position].distance = update.distance;
-			buffer[update.position].prevOffset = update.prevOffset;
+			TROTE_ASSERT(update.distance < PathBuffer::Node::unreached, "path is too long for packed node");
+			node.distance = static_cast<std::uint16_t>(update.distance);
+			node.prevStep = update.prevStep;
 
 			if (isTarget(world, update.position))
 				return update.position;
@@ -182,53 +548,453 @@ namespace util {
 				sf::Vector3i direction3D = util::make3D(direction, 0);
 				sf::Vector3i nextPos = update.position + direction3D;
 				if (world.tiles().isValidPosition(nextPos) && isPassable(world.tiles()[nextPos]))
-					queue.emplace(update.distance + 1, nextPos, -direction3D);
+					queue.emplace(update.distance + 1, nextPos, PathBuffer::encodeStep(-direction));
 			}
 
-			if (auto destination = world.upStairs(update.position))
-				queue.emplace(update.distance + 1, *destination, update.position - *destination);
-
-			if (auto destination = world.downStairs(update.position))
-				queue.emplace(update.distance + 1, *destination, update.position - *destination);
+			if (auto destination = world.stairsDestination(update.position))
+				queue.emplace(update.distance + 1, *destination, PathBuffer::Node::stairsStep);
 		}
 
 		return std::nullopt;
 	}
 
 	/// @brief Computes next move to tile satisfying isTarget
-	/// @param buffer Buffer reused to prevent allocating memory
+	/// @details Reuses path cached from the last call if its target still satisfies isTarget and position is on path
+	/// @param buffer Scratch buffer used if path should be recomputed
 	template <typename IsTarget>
 		requires std::convertible_to<std::invoke_result_t<IsTarget, const core::World&, sf::Vector3i>, bool>
 	std::optional<sf::Vector3i> nextExploreStep(const core::World& world, sf::Vector3i position,
-		                                        PathBuffer& buffer, const IsTarget& isTarget) {
+		                                        CachedPath& path, PathBuffer& buffer, const IsTarget& isTarget) {
 		TROTE_ASSERT(world.tiles().isValidPosition(position));
 
-		if (!buffer.lastTarget || !isTarget(world, *buffer.lastTarget) || !buffer.buffer[position].onPath) {
-			if (auto target = findExplorePath(world, position, buffer.buffer, isTarget))
-				buffer.lastTarget = target;
-			else
+		if (!path.target || !isTarget(world, *path.target) || !path.advanceTo(position)) {
+			if (auto target = findExplorePath(world, position, buffer, isTarget)) {
+				tracePath(world, buffer, position, *target, path);
+				path.target = target;
+			} else {
 				return std::nullopt;
+			}
 		}
 
-		buffer.buffer[position].onPath = true;
+		return path.nextOffset();
+	}
 
-		sf::Vector3i current = *buffer.lastTarget;
-		while (true) {
-			buffer.buffer[current].onPath = true;
+	/// @brief Distances from every passable tile to the nearest of the sources
+	/// @details Built by a single BFS crossing stairs,
+	/// so any number of actors chasing the sources reads its steps instead of running own searches
+	class DistanceField {
+	public:
+		inline const static std::uint16_t unreached = PathBuffer::Node::unreached;
+
+		/// Recomputes distances from sources
+		void compute(const core::World& world, const std::vector<sf::Vector3i>& sources) {
+			distances.assign(world.tiles().shape(), unreached);
+			frontier.clear();
+
+			for (sf::Vector3i source : sources) {
+				TROTE_ASSERT(distances.isValidPosition(source));
+				if (distances[source] != unreached)
+					continue;
+
+				distances[source] = 0;
+				frontier.push_back(source);
+			}
 
-			sf::Vector3i prevOffset = buffer.buffer[current].prevOffset;
+			for (size_t i = 0; i < frontier.size(); ++i) {
+				sf::Vector3i position = frontier[i];
+				int nextDistance = distances[position] + 1;
+				TROTE_ASSERT(nextDistance < unreached, "path is too long for distance field");
 
-			if (current + prevOffset == position)
-				return -buffer.buffer[current].prevOffset;
+				forEachNeighbour(world, position, [&, this](sf::Vector3i nextPos) {
+					if (distances[nextPos] != unreached || !core::isPassable(world.tiles()[nextPos]))
+						return;
 
-			if (prevOffset == sf::Vector3i{0, 0, 0})
-				return sf::Vector3i{0, 0, 0};
+					distances[nextPos] = static_cast<std::uint16_t>(nextDistance);
+					frontier.push_back(nextPos);
+				});
+			}
+		}
+
+		/// @brief Removes sources updating only distances which depended on them
+		/// @details Tiles which lost every neighbour one step closer to sources are found first,
+		/// then their distances are recomputed from the rest of the field.
+		/// Cost depends on the number of such tiles, not on dungeon volume
+		void removeSources(const core::World& world, std::span<const sf::Vector3i> sources) {
+			if (marks.shape() != distances.shape())
+				marks.assign(distances.shape(), Mark::NONE);
+			frontier.clear();
+
+			for (sf::Vector3i source : sources)
+				if (distances.isValidPosition(source) && distances[source] == 0 && marks[source] == Mark::NONE) {
+					marks[source] = Mark::AFFECTED;
+					frontier.push_back(source);
+				}
+
+			// Frontier is processed in order of distance so closer candidates are decided first
+			for (size_t i = 0; i < frontier.size(); ++i) {
+				sf::Vector3i position = frontier[i];
+				if (marks[position] == Mark::CANDIDATE) {
+					if (isSupported(world, position)) {
+						marks[position] = Mark::NONE;
+						continue;
+					}
+					marks[position] = Mark::AFFECTED;
+				}
+
+				forEachNeighbour(world, position, [&, this](sf::Vector3i nextPos) {
+					if (marks[nextPos] == Mark::NONE && distances[nextPos] == distances[position] + 1) {
+						marks[nextPos] = Mark::CANDIDATE;
+						frontier.push_back(nextPos);
+					}
+				});
+			}
+
+			BucketQueue<Update> queue;
+			for (sf::Vector3i position : frontier) {
+				if (marks[position] != Mark::AFFECTED)
+					continue;
+
+				int distance_ = unreached;
+				if (core::isPassable(world.tiles()[position]))
+					forEachNeighbour(world, position, [&, this](sf::Vector3i nextPos) {
+						if (marks[nextPos] != Mark::AFFECTED && distances[nextPos] != unreached)
+							distance_ = std::min(distance_, distances[nextPos] + 1);
+					});
+
+				distances[position] = static_cast<std::uint16_t>(distance_);
+				if (distance_ != unreached)
+					queue.push({distance_, position});
+			}
 
-			current += prevOffset;
+			while (!queue.empty()) {
+				Update update = queue.top();
+				queue.pop();
+				if (update.distance != distances[update.position])
+					continue;
+
+				forEachNeighbour(world, update.position, [&, this](sf::Vector3i nextPos) {
+					if (marks[nextPos] == Mark::AFFECTED && distances[nextPos] > update.distance + 1
+					 && core::isPassable(world.tiles()[nextPos])) {
+						distances[nextPos] = static_cast<std::uint16_t>(update.distance + 1);
+						queue.push({update.distance + 1, nextPos});
+					}
+				});
+			}
+
+			for (sf::Vector3i position : frontier)
+				marks[position] = Mark::NONE;
 		}
 
-		TROTE_ASSERT(false, "unreachable");
-	}
+		/// Distance from position to the nearest source or unreached
+		[[nodiscard]] std::uint16_t distance(sf::Vector3i position) const {
+			if (!distances.isValidPosition(position))
+				return unreached;
+			return distances[position];
+		}
+
+		/// @brief Computes move to the neighbour closest to the sources
+		/// @returns Zero if position is a source or no source is reachable
+		[[nodiscard]] sf::Vector3i nextStep(const core::World& world, sf::Vector3i position) const {
+			sf::Vector3i bestOffset{0, 0, 0};
+			std::uint16_t bestDistance = distance(position);
+
+			for (sf::Vector2i direction : util::nonzeroDirections<int>) {
+				sf::Vector3i offset = util::make3D(direction, 0);
+				if (std::uint16_t nextDistance = distance(position + offset); nextDistance < bestDistance) {
+					bestDistance = nextDistance;
+					bestOffset = offset;
+				}
+			}
+
+			if (auto destination = world.stairsDestination(position))
+				if (distance(*destination) < bestDistance)
+					bestOffset = *destination - position;
+
+			return bestOffset;
+		}
+	private:
+		enum class Mark : std::uint8_t {
+			NONE,
+			CANDIDATE,
+			AFFECTED,
+		};
+
+		struct Update {
+			int distance;
+			sf::Vector3i position;
+
+			/// Priority used by BucketQueue
+			[[nodiscard]] int key() const noexcept {
+				return distance;
+			}
+		};
+
+		util::Array3D<std::uint16_t> distances;
+		util::Array3D<Mark> marks;
+		std::vector<sf::Vector3i> frontier;
+
+		/// Calls f with every valid planar neighbour of position and stairs destination
+		template <typename F>
+		static void forEachNeighbour(const core::World& world, sf::Vector3i position, F&& f) {
+			for (sf::Vector2i direction : util::nonzeroDirections<int>) {
+				sf::Vector3i nextPos = position + util::make3D(direction, 0);
+				if (world.tiles().isValidPosition(nextPos))
+					f(nextPos);
+			}
+
+			if (auto destination = world.stairsDestination(position))
+				f(*destination);
+		}
+
+		/// Checks if some not affected neighbour is one step closer to sources
+		[[nodiscard]] bool isSupported(const core::World& world, sf::Vector3i position) const {
+			bool supported = false;
+			forEachNeighbour(world, position, [&, this](sf::Vector3i nextPos) {
+				supported |= marks[nextPos] != Mark::AFFECTED && distances[nextPos] + 1 == distances[position];
+			});
+			return supported;
+		}
+	};
+
+	/// @brief Pathfinding service shared by all actors
+	/// @details Owns a small pool of scratch PathBuffers so memory scales with active searches, not with population.
+	/// Actors keep only their CachedPath
+	class Pathfinder {
+	public:
+		/// @brief Computes next move to perform to move from position to target
+		/// @details Accepts the same search policies and passability predicates as util::nextStep.
+		/// Predicate may only forbid some tiles passable by core::isPassable (e.g. unseen ones),
+		/// so target in another Connectivity component is rejected without search anyway.
+		/// Target on another level is found hierarchically using StairGraph.
+		/// Path on the same level closed by changed tiles is repaired around them with repairClosed
+		template <typename Search = JumpPointSearch, typename... IsPassable>
+			requires (sizeof...(IsPassable) <= 1)
+		sf::Vector3i nextStep(const core::World& world, sf::Vector3i position, sf::Vector3i target,
+		                      CachedPath& path, const IsPassable&... isPassable) {
+			if (!connectivity.connected(world, position, target)) {
+				path.markUnreachable(position, target);
+				return {0, 0, 0};
+			}
+
+			if (position.z == target.z)
+				repairClosed<Search>(world, position, path, positionPredicate(isPassable...));
+			else
+				dropIfClosed(world, path);
+
+			Lease buffer{*this};
+			if (position.z != target.z)
+				return nextCrossLevelStep<Search>(world, position, target, path, *buffer, positionPredicate(isPassable...));
+			return util::nextStep<Search>(world, position, target, path, *buffer, isPassable...);
+		}
+
+		/// Computes next move to tile satisfying isTarget
+		template <typename IsTarget>
+		std::optional<sf::Vector3i> nextExploreStep(const core::World& world, sf::Vector3i position,
+		                                            CachedPath& path, const IsTarget& isTarget) {
+			dropIfClosed(world, path);
+			Lease buffer{*this};
+			return util::nextExploreStep(world, position, path, *buffer, isTarget);
+		}
+
+		/// @brief Computes next move to target chased by many actors (e.g. the player)
+		/// @details Reads it from the shared DistanceField recomputed only when target moved or after clear,
+		/// so each target position costs a single BFS whatever the number of chasers
+		sf::Vector3i nextFlowStep(const core::World& world, sf::Vector3i position, sf::Vector3i target) {
+			if (flowTarget != target) {
+				flowField.compute(world, {target});
+				flowTarget = target;
+				++flowFieldComputations_;
+			}
+
+			return flowField.nextStep(world, position);
+		}
+
+		/// Forces DistanceField, StairGraph and Connectivity to be recomputed. Should be called when dungeon is regenerated
+		void clear() noexcept {
+			flowTarget = std::nullopt;
+			stairGraph.clear();
+			connectivity.clear();
+			openedVersion = ++tilesVersion;
+		}
+
+		/// Drops only the state invalidated by changed tiles
+		void onChanges(const core::ChangeJournal& changes) {
+			if (changes.allTilesChanged()) {
+				clear();
+				return;
+			}
+
+			connectivity.onChanges(changes);
+			if (!changes.tiles().empty()) {
+				flowTarget = std::nullopt;
+				++tilesVersion;
+			}
+			for (const core::ChangeJournal::TileChange& change : changes.tiles()) {
+				stairGraph.invalidate(change.position.z);
+				if (core::isPassable(change.newTile) && !core::isPassable(change.oldTile))
+					openedVersion = tilesVersion;
+			}
+		}
+
+		/// Number of scratch buffers allocated so far
+		[[nodiscard]] ptrdiff_t allocatedBuffers() const noexcept {
+			return allocatedBuffers_;
+		}
+
+		/// Number of times DistanceField was recomputed
+		[[nodiscard]] ptrdiff_t flowFieldComputations() const noexcept {
+			return flowFieldComputations_;
+		}
+	private:
+		std::vector<std::unique_ptr<PathBuffer>> freeBuffers;
+		ptrdiff_t allocatedBuffers_ = 0;
+
+		DistanceField flowField;
+		std::optional<sf::Vector3i> flowTarget;
+		ptrdiff_t flowFieldComputations_ = 0;
+
+		StairGraph stairGraph;
+		Connectivity connectivity;
+
+		/// Incremented when tiles are changed so cached paths are checked only once after each change
+		std::uint32_t tilesVersion = 0;
+
+		/// Value of tilesVersion after the last change opening some tile
+		std::uint32_t openedVersion = 0;
+
+		/// @brief Drops path if some of its steps were closed since it was last checked
+		/// @details Unreachable marks are dropped after any change because opened tiles may connect their ends
+		void dropIfClosed(const core::World& world, CachedPath& path) const {
+			if (path.tilesVersion == tilesVersion)
+				return;
+
+			path.tilesVersion = tilesVersion;
+			if (path.steps.size() < 2 || !std::ranges::all_of(path.steps, [&world](sf::Vector3i step) {
+				return world.tiles().isValidPosition(step) && core::isPassable(world.tiles()[step]);
+			}))
+				path.target = std::nullopt;
+		}
+
+		/// @brief Repairs path if some of its steps were closed since it was last checked
+		/// @details Instead of searching the whole path again searches a detour from position
+		/// to the first open step after the closed ones and keeps the rest of the path.
+		/// Closing tiles never shortens paths, so a detour at most 2 steps longer than the replaced segment
+		/// counts as an extension: the path stays within 2 steps per extension of the shortest one.
+		/// Path is dropped if a tile was opened since it was checked (it may have made a shorter path),
+		/// if the detour is longer or if the target itself was closed
+		template <typename Search, typename IsPassable>
+		void repairClosed(const core::World& world, sf::Vector3i position, CachedPath& path, const IsPassable& isPassable) {
+			if (path.tilesVersion == tilesVersion)
+				return;
+
+			std::optional<sf::Vector3i> target = path.target;
+			bool onlyClosed = path.tilesVersion >= openedVersion;
+			dropIfClosed(world, path);
+			if (path.target || !target || !onlyClosed || path.partial
+			 || path.extensions >= CachedPath::maxExtensions || !path.advanceTo(position) || path.steps.size() < 2)
+				return;
+
+			auto firstClosed = std::find_if_not(path.steps.begin(), path.steps.end() - 1, [&world](sf::Vector3i step) {
+				return world.tiles().isValidPosition(step) && core::isPassable(world.tiles()[step]);
+			});
+			if (firstClosed == path.steps.begin() || firstClosed == path.steps.end() - 1)
+				return;
+
+			sf::Vector3i goal = *(firstClosed - 1);
+			ptrdiff_t replacedLength = path.steps.end() - firstClosed;
+			Lease buffer{*this};
+			Search::findPath(world, position, goal, *buffer, isPassable);
+			if ((*buffer)[goal].distance == PathBuffer::Node::unreached || (*buffer)[goal].distance > replacedLength + 2)
+				return;
+
+			std::vector<sf::Vector3i> kept(path.steps.begin(), firstClosed - 1);
+			int extensions = path.extensions;
+			tracePath(world, *buffer, position, goal, path);
+			path.steps.insert(path.steps.begin(), kept.begin(), kept.end());
+			path.target = target;
+			path.extensions = extensions + 1;
+		}
+
+		/// @brief Computes next move to target on another level
+		/// @details Only the segment to the first stairs chosen by StairGraph is refined,
+		/// the rest is refined when the actor reaches destination of these stairs.
+		/// StairGraph only takes stairs satisfying isPassable, but its distances inside levels ignore isPassable,
+		/// so if isPassable closes the way to the chosen stairs the whole path is searched instead
+		template <typename Search, typename IsPassable>
+		sf::Vector3i nextCrossLevelStep(const core::World& world, sf::Vector3i position, sf::Vector3i target,
+		                                CachedPath& path, PathBuffer& buffer, const IsPassable& isPassable) {
+			if (path.target == target && path.advanceTo(position) && path.steps.size() >= 2)
+				return path.nextOffset();
+
+			auto stairs = stairGraph.nextStairs(world, position, target, [&world, &isPassable](sf::Vector3i stairs) {
+				return isPassable(world, stairs);
+			});
+			if (!stairs) {
+				path.markUnreachable(position, target);
+				return {0, 0, 0};
+			}
+
+			Search::findPath(world, position, *stairs, buffer, isPassable);
+			tracePath(world, buffer, position, *stairs, path);
+			if (path.steps.front() != *stairs) {
+				Search::findPath(world, position, target, buffer, isPassable);
+				tracePath(world, buffer, position, target, path);
+				path.target = target;
+				return path.nextOffset();
+			}
+
+			path.steps.insert(path.steps.begin(), *world.stairsDestination(*stairs));
+			path.target = target;
+			path.partial = true;
+			return path.nextOffset();
+		}
+
+		/// Passability predicate used by nextCrossLevelStep when none is given
+		[[nodiscard]] static auto positionPredicate() {
+			return [](const core::World& world, sf::Vector3i pos) {
+				return core::isPassable(world.tiles()[pos]);
+			};
+		}
+
+		/// Wraps predicate taking Tile into one taking World and position
+		template <typename IsPassable>
+		[[nodiscard]] static auto positionPredicate(const IsPassable& isPassable) {
+			return [&isPassable](const core::World& world, sf::Vector3i pos) -> bool {
+				if constexpr (std::invocable<const IsPassable&, const core::World&, sf::Vector3i>)
+					return isPassable(world, pos);
+				else
+					return isPassable(world.tiles()[pos]);
+			};
+		}
+
+		/// Takes buffer from the pool and returns it back when destroyed
+		class Lease {
+		public:
+			Lease(Pathfinder& pathfinder_) : pathfinder{&pathfinder_} {
+				if (pathfinder->freeBuffers.empty()) {
+					buffer = std::make_unique<PathBuffer>();
+					++pathfinder->allocatedBuffers_;
+				} else {
+					buffer = std::move(pathfinder->freeBuffers.back());
+					pathfinder->freeBuffers.pop_back();
+				}
+			}
+
+			Lease(const Lease&) = delete;
+			Lease& operator = (const Lease&) = delete;
+
+			~Lease() {
+				pathfinder->freeBuffers.push_back(std::move(buffer));
+			}
+
+			PathBuffer& operator* () const noexcept {
+				return *buffer;
+			}
+		private:
+			Pathfinder* pathfinder;
+			std::unique_ptr<PathBuffer> buffer;
+		};
+	};
 }
 
 #endif
\ No newline at end of file
@@ -20,6 +20,12 @@ If not, see <https://www.gnu.org/licenses/>. */
 #include "geometry.hpp"
 #include "assert.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <span>
+
 namespace util {
 	namespace {
 		/// Checks if position1 and position2 are visible from each other
@@ -48,21 +54,83 @@ namespace util {
 			return false;
 		}
 
-		bool canSee(sf::Vector2i from, sf::Vector2i to, int z, const core::World& dungeon) {
-			const std::array<sf::Vector2<double>, 5> toCheck{ sf::Vector2<double>{-0.5, -0.5},
-																				 { 0.5, -0.5},
-																				 {-0.5,  0.5},
-																				 { 0.5,  0.5},
-																				 { 0.0,  0.0} };
+		/// @brief Appends offsets of the points checked by isObstructed for ray with given length
+		/// @details Uses exactly the same floating point operations, so offsets are the same.
+		/// They don't depend on ray start because it's offset by a multiple of 0.5 and such sums are exact
+		void appendRaySteps(sf::Vector2<double> length, std::vector<sf::Vector2<std::int16_t>>& steps) {
+			if (length == sf::Vector2<double>{0.0, 0.0})
+				return;
 
-			for (sf::Vector2<double> fromOffset : toCheck)
-				for (sf::Vector2<double> toOffset : toCheck)
-					if (!isObstructed(geometry_cast<double>(from) + fromOffset,
-						              geometry_cast<double>(to) + toOffset, z, dungeon))
-						return true;
+			double distance_ = util::distance({0.0, 0.0}, length);
 
-			return false;
+			double cos = length.x / distance_;
+			double sin = length.y / distance_;
+
+			double wholeDistance;
+			double offset = std::modf(distance_, &wholeDistance) / 2;
+
+			for (double distance = offset; distance <= distance_ - offset; ++distance)
+				steps.emplace_back(static_cast<std::int16_t>(std::round(distance * cos)),
+					               static_cast<std::int16_t>(std::round(distance * sin)));
 		}
+
+		/// Resets bits with indices in [begin, end)
+		void resetBits(std::span<std::uint64_t> bits, int begin, int end) noexcept {
+			while (begin < end) {
+				int bit = begin % 64;
+				int count = std::min(end - begin, 64 - bit);
+				std::uint64_t mask = count == 64 ? ~std::uint64_t{0} : ((std::uint64_t{1} << count) - 1) << bit;
+				bits[begin / 64] &= ~mask;
+				begin += count;
+			}
+		}
+
+		/// Extends rect to contain point
+		void extend(sf::IntRect& rect, sf::Vector2i point) noexcept {
+			if (rect.width <= 0 || rect.height <= 0) {
+				rect = {point.x, point.y, 1, 1};
+				return;
+			}
+
+			int right = std::max(rect.left + rect.width, point.x + 1);
+			int bottom = std::max(rect.top + rect.height, point.y + 1);
+			rect.left = std::min(rect.left, point.x);
+			rect.top = std::min(rect.top, point.y);
+			rect.width = right - rect.left;
+			rect.height = bottom - rect.top;
+		}
+
+		/// Ray ends relative to tile centers in half tiles. Center is first because its ray is most likely clear
+		const std::array<sf::Vector2i, 5> rayEnds{ sf::Vector2i{ 0,  0},
+												   sf::Vector2i{-1, -1},
+												   sf::Vector2i{ 1, -1},
+												   sf::Vector2i{-1,  1},
+												   sf::Vector2i{ 1,  1} };
+	}
+
+	bool castRays(const core::World& world, sf::Vector3i from, sf::Vector3i to) {
+		TROTE_ASSERT(world.tiles().isValidPosition(from));
+		TROTE_ASSERT(world.tiles().isValidPosition(to));
+
+		if (from == to)
+			return true;
+
+		if (from.z != to.z)
+			return false;
+
+		const std::array<sf::Vector2<double>, 5> toCheck{ sf::Vector2<double>{-0.5, -0.5},
+																			 { 0.5, -0.5},
+																			 {-0.5,  0.5},
+																			 { 0.5,  0.5},
+																			 { 0.0,  0.0} };
+
+		for (sf::Vector2<double> fromOffset : toCheck)
+			for (sf::Vector2<double> toOffset : toCheck)
+				if (!isObstructed(geometry_cast<double>(getXY(from)) + fromOffset,
+					              geometry_cast<double>(getXY(to)) + toOffset, from.z, world))
+					return true;
+
+		return false;
 	}
 
 	bool Raycaster::canSee(sf::Vector3i from, sf::Vector3i to) {
@@ -75,16 +143,157 @@ namespace util {
 		if (from.z != to.z)
 			return false;
 
-		auto from2D = getXY(from);
-		auto to2D = getXY(to);
-		int z = from.z;
+		Row& visibility = row(from);
+		int words = rowWords();
+		int index = to.x + to.y * world->tiles().shape().x;
+		std::uint64_t bit = std::uint64_t{1} << (index % 64);
+		std::uint64_t& known = visibility.bits[index / 64];
+		std::uint64_t& visible = visibility.bits[words + index / 64];
 
-		auto cache_iter = cache.find({ from2D, to2D, z });
-		if (cache_iter != cache.end())
-			return cache_iter->second;
-		
-		bool result = util::canSee(from2D, to2D, z, *world);
-		cache[{ from2D, to2D, z }] = result;
+		if (known & bit) {
+			++hits;
+			return visible & bit;
+		}
+
+		++misses;
+		bool result = hasClearRay(from, to);
+		known |= bit;
+		if (result)
+			visible |= bit;
+		extend(visibility.knownBounds, getXY(to));
 		return result;
 	}
+
+	void Raycaster::onChanges(const core::ChangeJournal& changes) {
+		if (changes.allTilesChanged()) {
+			clear();
+			return;
+		}
+
+		bool updatePassable = passableValid && world->tiles().shape() == preparedShape;
+		for (const core::ChangeJournal::TileChange& change : changes.tiles()) {
+			if (core::isPassable(change.oldTile) == core::isPassable(change.newTile))
+				continue;
+
+			if (updatePassable) {
+				sf::Vector3i position = change.position;
+				int index = position.x + (position.y + position.z * preparedShape.y) * preparedShape.x;
+				std::uint64_t bit = std::uint64_t{1} << (index % 64);
+				if (core::isPassable(change.newTile))
+					passable[index / 64] |= bit;
+				else
+					passable[index / 64] &= ~bit;
+			}
+
+			invalidate(change.position);
+		}
+	}
+
+	void Raycaster::invalidate(sf::Vector3i changed) {
+		sf::Vector3i shape = world->tiles().shape();
+		int words = rowWords();
+
+		cache.forEach([&](std::uint64_t key, Row& visibility) {
+			sf::Vector3i origin_ = origin(key);
+			if (origin_.z != changed.z || visibility.knownBounds.width <= 0)
+				return;
+
+			// ray from origin_ to target reaches changed tile only if it's in their bounding rect expanded by 1
+			int left   = changed.x > origin_.x + 1 ? changed.x - 1 : 0;
+			int right  = changed.x < origin_.x - 1 ? changed.x + 1 : shape.x - 1;
+			int top    = changed.y > origin_.y + 1 ? changed.y - 1 : 0;
+			int bottom = changed.y < origin_.y - 1 ? changed.y + 1 : shape.y - 1;
+
+			const sf::IntRect& bounds = visibility.knownBounds;
+			left   = std::max(left, bounds.left);
+			right  = std::min(right, bounds.left + bounds.width - 1);
+			top    = std::max(top, bounds.top);
+			bottom = std::min(bottom, bounds.top + bounds.height - 1);
+
+			std::span<std::uint64_t> known{visibility.bits.data(), static_cast<size_t>(words)};
+			std::span<std::uint64_t> visible{visibility.bits.data() + words, static_cast<size_t>(words)};
+			for (int y = top; y <= bottom; ++y) {
+				resetBits(known, left + y * shape.x, right + 1 + y * shape.x);
+				resetBits(visible, left + y * shape.x, right + 1 + y * shape.x);
+			}
+		});
+	}
+
+	bool Raycaster::hasClearRay(sf::Vector3i from, sf::Vector3i to) {
+		prepare();
+
+		// tile is visible if any ray is clear, so rays may be checked in any order
+		for (sf::Vector2i fromEnd : rayEnds)
+			for (sf::Vector2i toEnd : rayEnds)
+				if (!isObstructed(2 * getXY(from) + fromEnd, 2 * getXY(to) + toEnd, from.z))
+					return true;
+
+		return false;
+	}
+
+	void Raycaster::prepare() {
+		sf::Vector3i shape = world->tiles().shape();
+		if (shape != preparedShape) {
+			preparedShape = shape;
+			rayTemplates.assign(static_cast<size_t>(2 * shape.x + 1) * (2 * shape.y + 1), RayTemplate{});
+			raySteps.clear();
+			passableValid = false;
+		}
+
+		if (passableValid)
+			return;
+
+		passable.assign((static_cast<size_t>(shape.x) * shape.y * shape.z + 63) / 64, 0);
+		for (int z = 0; z < shape.z; ++z)
+			for (int y = 0; y < shape.y; ++y)
+				for (int x = 0; x < shape.x; ++x)
+					if (core::isPassable(world->tiles()[{x, y, z}])) {
+						int index = x + (y + z * shape.y) * shape.x;
+						passable[index / 64] |= std::uint64_t{1} << (index % 64);
+					}
+		passableValid = true;
+	}
+
+	bool Raycaster::isObstructed(sf::Vector2i from, sf::Vector2i to, int z) {
+		sf::Vector2i length = to - from;
+		sf::Vector2i sign{length.x < 0 ? -1 : 1, length.y < 0 ? -1 : 1};
+		// rounding is symmetrical, so mirrored ray checks mirrored offsets
+		const RayTemplate& template_ = rayTemplate(std::abs(length.x), std::abs(length.y));
+
+		for (int i = template_.begin; i < template_.begin + template_.size; ++i) {
+			// integer division truncates like cast of double to int
+			int x = (from.x + 2 * sign.x * raySteps[i].x) / 2;
+			int y = (from.y + 2 * sign.y * raySteps[i].y) / 2;
+
+			if (x < 0 || x >= preparedShape.x || y < 0 || y >= preparedShape.y || !isPassable(x, y, z))
+				return true;
+		}
+
+		return false;
+	}
+
+	const Raycaster::RayTemplate& Raycaster::rayTemplate(int lengthX, int lengthY) {
+		RayTemplate& template_ = rayTemplates[lengthX + lengthY * (2 * preparedShape.x + 1)];
+		if (template_.begin < 0) {
+			template_.begin = static_cast<std::int32_t>(raySteps.size());
+			appendRaySteps({lengthX / 2.0, lengthY / 2.0}, raySteps);
+			template_.size = static_cast<std::int32_t>(raySteps.size()) - template_.begin;
+		}
+		return template_;
+	}
+
+	Raycaster::Row& Raycaster::row(sf::Vector3i origin) {
+		std::uint64_t key = cacheKey(origin);
+		if (Row* cached = cache.find(key))
+			return *cached;
+
+		Row& inserted = cache.insertRecycled(key);
+		inserted.bits.assign(2 * rowWords(), 0);
+		inserted.knownBounds = {};
+		return inserted;
+	}
+
+	int Raycaster::rowWords() const noexcept {
+		return (world->tiles().shape().x * world->tiles().shape().y + 63) / 64;
+	}
 }
@@ -17,16 +17,29 @@ If not, see <https://www.gnu.org/licenses/>. */
 #define RAYCAST_HPP_
 
 #include "core/fwd.hpp"
+#include "core/ChangeJournal.hpp"
 
 #include <util/geometry.hpp>
-#include <util/Map.hpp>
+#include <util/ClockCache.hpp>
 
 #include <SFML/System/Vector3.hpp>
 
+#include <cstdint>
 #include <memory>
-#include <tuple>
+#include <vector>
 
 namespace util {
+	/// @brief Checks if tile at to can be seen from tile at from casting rays between their corners and centers
+	/// @details Reference implementation of Raycaster::canSee without any caches, slow
+	[[nodiscard]] bool castRays(const core::World& world, sf::Vector3i from, sf::Vector3i to);
+
+	/// @brief Checks visibility between tiles casting several rays between their corners and centers
+	/// @details Results are cached in visibility rows, one for each origin tile.
+	/// Row holds a bit for each tile of the origin level telling if it's already known and a bit telling if it's visible.
+	/// Bits are computed on demand, the number of rows is bounded, least recently used rows are evicted first.
+	/// 
+	/// Rays are walked with integer steps precomputed once for each ray direction and length
+	/// against a passability bitplane, giving exactly the same results as castRays
 	class Raycaster {
 	public:
 		Raycaster(std::shared_ptr<core::World> world_) :
@@ -38,11 +51,101 @@ namespace util {
 		/// Clears cache to prevent bugs
 		void clear() {
 			cache.clear();
+			passableValid = false;
+		}
+
+		/// @brief Forgets only results that may be changed by changed tiles
+		/// @details Result for a pair of tiles is kept if changed tile is outside of their bounding rect expanded by 1,
+		/// rays between them never reach it. Bulk changes clear the whole cache
+		void onChanges(const core::ChangeJournal& changes);
+
+		/// Number of canSee results taken from the cache
+		[[nodiscard]] ptrdiff_t cacheHits() const noexcept {
+			return hits;
 		}
+
+		/// Number of canSee results that had to be computed
+		[[nodiscard]] ptrdiff_t cacheMisses() const noexcept {
+			return misses;
+		}
+
+		/// Number of visibility rows dropped to make room for new ones
+		[[nodiscard]] ptrdiff_t cacheEvictions() const noexcept {
+			return cache.evictions();
+		}
+
+		/// Maximal number of cached visibility rows, bounds memory used by the cache
+		static constexpr int cacheCapacity = 1 << 12;
 	private:
 		std::shared_ptr<core::World> world;
 
-		UnorderedMap<std::tuple<sf::Vector2i, sf::Vector2i, int>, bool> cache;
+		struct Row {
+			/// @brief Known bits of the row followed by visible bits
+			/// @details Tile (x, y) has bit x + y * width in each half
+			std::vector<std::uint64_t> bits;
+			/// Bounding rect of targets with known bits, lets onChanges skip rows quickly
+			sf::IntRect knownBounds;
+		};
+
+		ClockCache<Row> cache{cacheCapacity};
+		ptrdiff_t hits = 0;
+		ptrdiff_t misses = 0;
+
+		/// @brief Bit x + (y + z * height) * width is set if tile (x, y, z) is passable
+		/// @details Rebuilt lazily after clear
+		std::vector<std::uint64_t> passable;
+		bool passableValid = false;
+
+		/// Tiles checked by ray with nonnegative length in half tiles
+		struct RayTemplate {
+			std::int32_t begin = -1; ///< -1 if template isn't computed yet
+			std::int32_t size = 0;
+		};
+
+		/// Template for (x, y) half tiles long ray has index x + y * (2 * width + 1)
+		std::vector<RayTemplate> rayTemplates;
+		/// Offsets from the ray start to the checked tiles for all computed templates
+		std::vector<sf::Vector2<std::int16_t>> raySteps;
+		sf::Vector3i preparedShape{0, 0, 0};
+
+		/// Resets templates if world shape changed and rebuilds passability bitplane if needed
+		void prepare();
+
+		/// Checks if any of rays between corners and centers of tiles from and to is clear
+		[[nodiscard]] bool hasClearRay(sf::Vector3i from, sf::Vector3i to);
+
+		/// @brief Checks if ray between points is blocked by a wall
+		/// @details Points are in half tiles, so tile (x, y) has center (2 * x, 2 * y)
+		[[nodiscard]] bool isObstructed(sf::Vector2i from, sf::Vector2i to, int z);
+
+		[[nodiscard]] const RayTemplate& rayTemplate(int lengthX, int lengthY);
+
+		/// @warning position should be valid
+		[[nodiscard]] bool isPassable(int x, int y, int z) const noexcept {
+			int index = x + (y + z * preparedShape.y) * preparedShape.x;
+			return passable[index / 64] >> (index % 64) & 1;
+		}
+
+		/// Forgets results for the pairs of tiles whose rays may pass through changed tile
+		void invalidate(sf::Vector3i changed);
+
+		/// Visibility row for origin, inserts empty row if there isn't one
+		[[nodiscard]] Row& row(sf::Vector3i origin);
+
+		/// Number of 64 bit words in each half of the row
+		[[nodiscard]] int rowWords() const noexcept;
+
+		[[nodiscard]] static std::uint64_t cacheKey(sf::Vector3i origin) noexcept {
+			return static_cast<std::uint64_t>(origin.x)
+				 | static_cast<std::uint64_t>(origin.y) << 16
+				 | static_cast<std::uint64_t>(origin.z) << 32;
+		}
+
+		[[nodiscard]] static sf::Vector3i origin(std::uint64_t cacheKey) noexcept {
+			return {static_cast<int>(cacheKey & 0xFFFF),
+					static_cast<int>(cacheKey >> 16 & 0xFFFF),
+					static_cast<int>(cacheKey >> 32)};
+		}
 	};
 }
 
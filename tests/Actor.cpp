@@ -17,6 +17,10 @@ If not, see <https://www.gnu.org/licenses/>. */
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
 namespace {
 	class TestController : public core::Controller {
 	public:
@@ -72,12 +76,14 @@ namespace {
 	}
 
 	std::shared_ptr<core::Actor> makeSharedTestActor(double maxHp, double regen, double damage, double turnDelay) {
-		return std::make_shared<core::Actor>(makeTestActor(maxHp, regen, damage, turnDelay));
+		return std::make_shared<core::Actor>(makeTestStats(maxHp, regen, damage, turnDelay),
+											 "test", nullptr, testXpManager, nullptr, nullptr);
 	}
 
 	std::shared_ptr<core::Actor> makeSharedTestActor(double maxHp, double regen, double damage, double turnDelay, 
 		                                             std::shared_ptr<core::XpManager> xpManager) {
-		return std::make_shared<core::Actor>(makeTestActor(maxHp, regen, damage, turnDelay, xpManager));
+		return std::make_shared<core::Actor>(makeTestStats(maxHp, regen, damage, turnDelay),
+											 "test", nullptr, std::move(xpManager), nullptr, nullptr);
 	}
 
 	std::shared_ptr<core::Actor> makeSharedTestActor(sf::Vector3i pos, std::shared_ptr<core::World> world) {
@@ -227,3 +233,110 @@ TEST(Actor, tryMoveToForceSwap) {
 	EXPECT_TRUE(dynamic_cast<TestController&>(actor->controller()).hadSwapped());
 	EXPECT_TRUE(dynamic_cast<TestController&>(other->controller()).hadSwapped());
 }
+
+TEST(Actor, tryMoveToUpdatesActorAt) {
+	auto [actor, other] = createAliveActorTryMoveToTest();
+
+	actor->tryMoveTo({ 1, 2, 0 }, false);
+	EXPECT_EQ(actor->world().actorAt(sf::Vector3i{ 1, 2, 0 }), actor);
+	EXPECT_EQ(actor->world().actorAt(sf::Vector3i{ 0, 1, 0 }), nullptr);
+}
+
+TEST(Actor, tryMoveToSwapUpdatesActorAt) {
+	auto [actor, other] = createAliveActorTryMoveToTest();
+
+	actor->tryMoveTo({ 0, 2, 0 }, false);
+	EXPECT_EQ(actor->world().actorAt(sf::Vector3i{ 0, 2, 0 }), actor);
+	EXPECT_EQ(actor->world().actorAt(sf::Vector3i{ 0, 1, 0 }), other);
+}
+
+TEST(Actor, handle) {
+	auto world = std::make_shared<core::World>();
+	auto actor = makeSharedTestActor({ 0, 0, 0 }, world);
+
+	auto handle = actor->handle();
+	EXPECT_EQ(world->actorTable().get(handle), actor.get());
+
+	actor.reset();
+	EXPECT_EQ(world->actorTable().get(handle), nullptr);
+}
+
+TEST(Actor, handleIsPlainData) {
+	static_assert(std::is_trivially_copyable_v<core::ActorHandle>);
+	static_assert(sizeof(core::ActorHandle) == sizeof(int) + sizeof(uint32_t));
+
+	auto world = std::make_shared<core::World>();
+	auto actor = makeSharedTestActor({ 0, 0, 0 }, world);
+
+	auto handle = actor->handle();
+	core::ActorHandle restored{ handle.index(), handle.generation() };
+	EXPECT_EQ(restored, handle);
+	EXPECT_EQ(world->actorTable().get(restored), actor.get());
+}
+
+TEST(Actor, ref) {
+	auto world = std::make_shared<core::World>();
+	auto actor = makeSharedTestActor({ 0, 0, 0 }, world);
+
+	auto ref = actor->ref();
+	EXPECT_EQ(ref.get(), actor.get());
+	EXPECT_EQ(ref.handle(), actor->handle());
+	EXPECT_FALSE(ref.expired());
+
+	actor.reset();
+	EXPECT_EQ(ref.get(), nullptr);
+	EXPECT_TRUE(ref.expired());
+}
+
+TEST(Actor, handleReusedSlot) {
+	auto world = std::make_shared<core::World>();
+	auto actor = makeSharedTestActor({ 0, 0, 0 }, world);
+	auto oldRef = actor->ref();
+	actor.reset();
+
+	auto other = makeSharedTestActor({ 0, 0, 0 }, world);
+	EXPECT_EQ(other->handle().index(), oldRef.handle().index());
+	EXPECT_NE(other->handle(), oldRef.handle());
+	EXPECT_TRUE(oldRef.expired());
+	EXPECT_EQ(other->ref().get(), other.get());
+}
+
+TEST(Actor, refWithoutWorld) {
+	auto actor = makeSharedTestActor(5.0, 1.0, 1.0, 1);
+	EXPECT_EQ(actor->ref().get(), actor.get());
+}
+
+TEST(Actor, hotFieldsInTable) {
+	auto world = std::make_shared<core::World>();
+	auto actor = makeSharedTestActor({ 1, 2, 0 }, world);
+	actor->hp(0.5);
+
+	int slot = actor->handle().index();
+	const auto& table = world->actorTable();
+	EXPECT_EQ(table.positions()[slot], sf::Vector3i(1, 2, 0));
+	EXPECT_EQ(table.hps()[slot], 0.5);
+	EXPECT_FALSE(table.isOnPlayerSide()[slot]);
+
+	actor.reset();
+	EXPECT_EQ(table.hps()[slot], 0);
+}
+
+TEST(Actor, slotsOnLevel) {
+	auto world = std::make_shared<core::World>();
+	auto actor = makeSharedTestActor({ 1, 2, 0 }, world);
+	auto other = makeSharedTestActor({ 0, 0, 1 }, world);
+	int slot = actor->handle().index();
+	int otherSlot = other->handle().index();
+	const auto& table = world->actorTable();
+	EXPECT_TRUE(std::ranges::equal(table.slotsOnLevel(0), std::vector{ slot }));
+	EXPECT_TRUE(std::ranges::equal(table.slotsOnLevel(1), std::vector{ otherSlot }));
+
+	actor->position({ 3, 3, 1 });
+	EXPECT_TRUE(table.slotsOnLevel(0).empty());
+	EXPECT_EQ(std::ranges::count(table.slotsOnLevel(1), slot), 1);
+	EXPECT_EQ(std::ranges::count(table.slotsOnLevel(1), otherSlot), 1);
+
+	other.reset();
+	EXPECT_TRUE(std::ranges::equal(table.slotsOnLevel(1), std::vector{ slot }));
+	EXPECT_TRUE(table.slotsOnLevel(5).empty());
+}
@@ -0,0 +1,78 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+#include "util/BucketQueue.hpp"
+
+#include <gtest/gtest.h>
+
+namespace {
+	struct Value {
+		int key_;
+		int id;
+
+		int key() const noexcept {
+			return key_;
+		}
+	};
+
+	std::vector<int> popAll(util::BucketQueue<Value>& queue) {
+		std::vector<int> order;
+		while (!queue.empty()) {
+			order.push_back(queue.top().id);
+			queue.pop();
+		}
+		return order;
+	}
+}
+
+TEST(BucketQueue, order) {
+	util::BucketQueue<Value> queue;
+	queue.push({5, 0});
+	queue.push({2, 1});
+	queue.push({7, 2});
+	queue.push({1, 3});
+	queue.push({3, 4});
+
+	EXPECT_EQ(popAll(queue), (std::vector<int>{3, 1, 4, 0, 2}));
+}
+
+TEST(BucketQueue, equalKeysLifo) {
+	util::BucketQueue<Value> queue;
+	queue.push({1, 0});
+	queue.push({1, 1});
+	queue.push({0, 2});
+
+	EXPECT_EQ(popAll(queue), (std::vector<int>{2, 1, 0}));
+}
+
+TEST(BucketQueue, pushBelowCurrent) {
+	util::BucketQueue<Value> queue;
+	queue.push({4, 0});
+	queue.push({6, 1});
+	queue.pop();
+
+	queue.push({2, 2});
+	EXPECT_EQ(queue.top().id, 2);
+	EXPECT_EQ(queue.size(), 2);
+}
+
+TEST(BucketQueue, reuseAfterEmpty) {
+	util::BucketQueue<Value> queue;
+	queue.push({10, 0});
+	queue.pop();
+
+	queue.push({3, 1});
+	queue.push({12, 2});
+	EXPECT_EQ(popAll(queue), (std::vector<int>{1, 2}));
+}
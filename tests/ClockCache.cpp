@@ -0,0 +1,89 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "util/ClockCache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+TEST(ClockCache, findInserted) {
+	util::ClockCache<int> cache{4};
+	cache.insert(1, 10);
+	cache.insert(2, 20);
+
+	ASSERT_NE(cache.find(1), nullptr);
+	EXPECT_EQ(*cache.find(1), 10);
+	ASSERT_NE(cache.find(2), nullptr);
+	EXPECT_EQ(*cache.find(2), 20);
+	EXPECT_EQ(cache.find(3), nullptr);
+
+	EXPECT_EQ(cache.hits(), 4);
+	EXPECT_EQ(cache.misses(), 1);
+}
+
+TEST(ClockCache, boundedSize) {
+	util::ClockCache<int> cache{8};
+	for (int i = 0; i < 100; ++i)
+		cache.insert(i, i);
+
+	EXPECT_EQ(cache.size(), 8);
+	EXPECT_EQ(cache.evictions(), 92);
+
+	int found = 0;
+	for (int i = 0; i < 100; ++i)
+		if (const int* value = cache.find(i)) {
+			EXPECT_EQ(*value, i);
+			++found;
+		}
+	EXPECT_EQ(found, 8);
+}
+
+TEST(ClockCache, keepsReferenced) {
+	util::ClockCache<int> cache{3};
+	cache.insert(1, 1);
+	cache.insert(2, 2);
+	cache.insert(3, 3);
+
+	static_cast<void>(cache.find(1));
+	cache.insert(4, 4);
+
+	EXPECT_NE(cache.find(1), nullptr);
+	EXPECT_EQ(cache.find(2), nullptr);
+	EXPECT_NE(cache.find(3), nullptr);
+	EXPECT_NE(cache.find(4), nullptr);
+}
+
+TEST(ClockCache, clear) {
+	util::ClockCache<int> cache{4};
+	cache.insert(1, 1);
+	cache.clear();
+
+	EXPECT_EQ(cache.size(), 0);
+	EXPECT_EQ(cache.find(1), nullptr);
+
+	cache.insert(1, 2);
+	EXPECT_EQ(*cache.find(1), 2);
+}
+
+TEST(ClockCache, insertRecycled) {
+	util::ClockCache<std::vector<int>> cache{1};
+	cache.insert(1, std::vector<int>{1, 2, 3});
+
+	std::vector<int>& recycled = cache.insertRecycled(2);
+	EXPECT_EQ(recycled, (std::vector<int>{1, 2, 3}));
+	EXPECT_EQ(cache.find(1), nullptr);
+	EXPECT_EQ(cache.find(2), &recycled);
+}
@@ -0,0 +1,87 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "util/FieldOfView.hpp"
+
+#include "core/World.hpp"
+
+#include "util/random.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(FieldOfView, empty) {
+    core::World world;
+    world.tiles().assign({ 5, 4, 2 }, core::Tile::EMPTY);
+
+    util::FieldOfView fov;
+    fov.compute(world, { 1, 2, 0 });
+    for (int x = 0; x < 5; ++x)
+        for (int y = 0; y < 4; ++y) {
+            EXPECT_TRUE(fov.isVisible({ x, y, 0 }));
+            EXPECT_FALSE(fov.isVisible({ x, y, 1 }));
+        }
+}
+
+TEST(FieldOfView, wall) {
+    core::World world;
+    world.tiles().assign({ 3, 3, 1 }, core::Tile::EMPTY);
+    for (int x = 0; x < 3; ++x)
+        world.tiles()[{x, 1, 0}] = core::Tile::WALL;
+
+    util::FieldOfView fov;
+    fov.compute(world, { 1, 0, 0 });
+    for (int x = 0; x < 3; ++x) {
+        EXPECT_TRUE(fov.isVisible({ x, 0, 0 }));
+        EXPECT_TRUE(fov.isVisible({ x, 1, 0 }));
+        EXPECT_FALSE(fov.isVisible({ x, 2, 0 }));
+    }
+}
+
+TEST(FieldOfView, pillarShadow) {
+    core::World world;
+    world.tiles().assign({ 7, 3, 1 }, core::Tile::EMPTY);
+    world.tiles()[{2, 1, 0}] = core::Tile::WALL;
+
+    util::FieldOfView fov;
+    fov.compute(world, { 0, 1, 0 });
+    EXPECT_TRUE(fov.isVisible({ 2, 1, 0 }));
+    EXPECT_FALSE(fov.isVisible({ 3, 1, 0 }));
+    EXPECT_FALSE(fov.isVisible({ 6, 1, 0 }));
+    EXPECT_TRUE(fov.isVisible({ 3, 0, 0 }));
+}
+
+TEST(FieldOfView, symmetric) {
+    util::RandomEngine randomEngine{3};
+    core::World world;
+    world.tiles().assign({ 16, 16, 1 }, core::Tile::EMPTY);
+    for (int x = 0; x < 16; ++x)
+        for (int y = 0; y < 16; ++y)
+            if (std::bernoulli_distribution{0.2}(randomEngine))
+                world.tiles()[{x, y, 0}] = core::Tile::WALL;
+
+    std::vector<util::FieldOfView> fovs(16 * 16);
+    for (int x = 0; x < 16; ++x)
+        for (int y = 0; y < 16; ++y)
+            if (core::isPassable(world.tiles()[{x, y, 0}]))
+                fovs[x + y * 16].compute(world, { x, y, 0 });
+
+    for (int x1 = 0; x1 < 16; ++x1)
+        for (int y1 = 0; y1 < 16; ++y1)
+            for (int x2 = 0; x2 < 16; ++x2)
+                for (int y2 = 0; y2 < 16; ++y2)
+                    if (core::isPassable(world.tiles()[{x1, y1, 0}]) && core::isPassable(world.tiles()[{x2, y2, 0}])) {
+                        ASSERT_EQ(fovs[x1 + y1 * 16].isVisible({ x2, y2, 0 }), fovs[x2 + y2 * 16].isVisible({ x1, y1, 0 }));
+                    }
+}
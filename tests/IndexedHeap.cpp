@@ -0,0 +1,77 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+
+#include "util/IndexedHeap.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(IndexedHeap, order) {
+	util::IndexedHeap<double> heap;
+	heap.push(0, 5);
+	heap.push(1, 2);
+	heap.push(2, 7);
+	heap.push(3, 1);
+	heap.push(4, 3);
+
+	std::vector<int> order;
+	while (!heap.empty()) {
+		order.push_back(heap.top());
+		heap.pop();
+	}
+
+	EXPECT_EQ(order, (std::vector<int>{3, 1, 4, 0, 2}));
+}
+
+TEST(IndexedHeap, update) {
+	util::IndexedHeap<double> heap;
+	heap.push(0, 5);
+	heap.push(1, 2);
+	heap.push(2, 7);
+
+	heap.update(2, 1);
+	EXPECT_EQ(heap.top(), 2);
+
+	heap.update(2, 10);
+	EXPECT_EQ(heap.top(), 1);
+	EXPECT_EQ(heap.key(2), 10);
+}
+
+TEST(IndexedHeap, erase) {
+	util::IndexedHeap<double> heap;
+	for (int i = 0; i < 10; ++i)
+		heap.push(i, 10 - i);
+
+	heap.erase(9);
+	heap.erase(4);
+
+	EXPECT_FALSE(heap.contains(9));
+	EXPECT_FALSE(heap.contains(4));
+	EXPECT_EQ(heap.size(), 8);
+	EXPECT_EQ(heap.top(), 8);
+}
+
+TEST(IndexedHeap, relabel) {
+	util::IndexedHeap<double> heap;
+	heap.push(0, 5);
+	heap.push(3, 2);
+
+	heap.erase(0);
+	heap.relabel(3, 0);
+
+	EXPECT_TRUE(heap.contains(0));
+	EXPECT_FALSE(heap.contains(3));
+	EXPECT_EQ(heap.top(), 0);
+	EXPECT_EQ(heap.topKey(), 2);
+}
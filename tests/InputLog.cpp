@@ -0,0 +1,112 @@
+/* This file is part of the Rune of the Eldest.
+The Rune of the Eldest - Roguelike about the mage seeking for ancient knowledges
+Copyright (C) 2023  PJutch
+
+The Rune of the Eldest is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+The Rune of the Eldest is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with the Rune of the Eldest.
+If not, see <https://www.gnu.org/licenses/>. */
+#include "InputLog.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+namespace {
+    std::filesystem::path tempLogPath() {
+        return std::filesystem::temp_directory_path() / "trote_input_log_test.bin";
+    }
+
+    sf::Event keyPressed(sf::Keyboard::Key code, bool shift) {
+        sf::Event event{ sf::Event::KeyPressed };
+        event.key.code = code;
+        event.key.shift = shift;
+        return event;
+    }
+
+    sf::Event mouseButtonPressed(sf::Mouse::Button button, int x, int y) {
+        sf::Event event{ sf::Event::MouseButtonPressed };
+        event.mouseButton = sf::Event::MouseButtonEvent{ button, x, y };
+        return event;
+    }
+}
+
+TEST(InputLog, header) {
+    auto path = tempLogPath();
+    {
+        InputRecorder recorder{path, 1234567890123ULL, {1920, 1080}};
+    }
+
+    InputReplay replay{path};
+    EXPECT_EQ(replay.seed(), 1234567890123ULL);
+    EXPECT_EQ(replay.windowSize(), (sf::Vector2u{1920, 1080}));
+    std::filesystem::remove(path);
+}
+
+TEST(InputLog, frames) {
+    auto path = tempLogPath();
+    {
+        InputRecorder recorder{path, 42, {800, 600}};
+        recorder.endFrame();
+
+        recorder.record({ keyPressed(sf::Keyboard::Comma, true) });
+        recorder.record({ mouseButtonPressed(sf::Mouse::Left, 300, -5), { 12.25f, -3.5f, 4 } });
+        recorder.endFrame();
+
+        recorder.endFrame();
+
+        recorder.record({ keyPressed(sf::Keyboard::Numpad7, false) });
+        recorder.endFrame();
+    }
+
+    InputReplay replay{path};
+    std::vector<RecordedEvent> events;
+
+    ASSERT_TRUE(replay.nextFrame(events));
+    EXPECT_TRUE(events.empty());
+
+    ASSERT_TRUE(replay.nextFrame(events));
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[0].event.type, sf::Event::KeyPressed);
+    EXPECT_EQ(events[0].event.key.code, sf::Keyboard::Comma);
+    EXPECT_TRUE(events[0].event.key.shift);
+    EXPECT_FALSE(events[0].event.key.control);
+    EXPECT_EQ(events[1].event.type, sf::Event::MouseButtonPressed);
+    EXPECT_EQ(events[1].event.mouseButton.button, sf::Mouse::Left);
+    EXPECT_EQ(events[1].event.mouseButton.x, 300);
+    EXPECT_EQ(events[1].event.mouseButton.y, -5);
+    EXPECT_EQ(events[1].cameraPosition, (core::Position<float>{ 12.25f, -3.5f, 4 }));
+
+    ASSERT_TRUE(replay.nextFrame(events));
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(events[0].event.key.code, sf::Keyboard::Numpad7);
+    EXPECT_FALSE(events[0].event.key.shift);
+
+    EXPECT_FALSE(replay.nextFrame(events));
+    std::filesystem::remove(path);
+}
+
+TEST(InputLog, ignoresUnusedEvents) {
+    sf::Event event{ sf::Event::MouseMoved };
+    event.mouseMove = sf::Event::MouseMoveEvent{ 10, 15 };
+
+    EXPECT_FALSE(InputRecorder::isRecorded(event));
+    EXPECT_TRUE(InputRecorder::isRecorded(keyPressed(sf::Keyboard::A, false)));
+}
+
+TEST(InputLog, notALog) {
+    auto path = tempLogPath();
+    {
+        std::ofstream file{path};
+        file << "definitely not an input log";
+    }
+
+    EXPECT_THROW(InputReplay{path}, InputReplay::ReadError);
+    std::filesystem::remove(path);
+}
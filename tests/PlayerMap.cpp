@@ -23,6 +23,8 @@ If not, see <https://www.gnu.org/licenses/>. */
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <random>
+#include <vector>
 
 namespace {
     class TestController : public core::Controller {
@@ -57,7 +59,7 @@ TEST(PlayerMap, tileVisibilityEmpty) {
     auto player = makeTestActor({ 0, 2, 0 });
     world->player(std::move(player));
 
-    render::PlayerMap playerMap{ world, nullptr, std::make_shared<util::Raycaster>(world) };
+    render::PlayerMap playerMap{ world, nullptr };
     playerMap.onGenerate();
     playerMap.update();
 
@@ -85,7 +87,7 @@ TEST(PlayerMap, tileVisibilityWall) {
     auto world = createWallWorld();
     world->player().position({ 1, 0, 0 });
 
-    render::PlayerMap playerMap{ world, nullptr, std::make_shared<util::Raycaster>(world) };
+    render::PlayerMap playerMap{ world, nullptr };
     playerMap.onGenerate();
     playerMap.update();
 
@@ -100,7 +102,7 @@ TEST(PlayerMap, tileVisibilityWall) {
 TEST(PlayerMap, tileMemorization) {
     auto world = createWallWorld();
 
-    render::PlayerMap playerMap{ world, nullptr, std::make_shared<util::Raycaster>(world) };
+    render::PlayerMap playerMap{ world, nullptr };
     playerMap.onGenerate();
 
     world->player().position({ 1, 0, 0 });
@@ -116,6 +118,24 @@ TEST(PlayerMap, tileMemorization) {
         EXPECT_EQ(playerMap.tileState({ x, 2, 0 }), render::PlayerMap::TileState::VISIBLE);
 }
 
+TEST(PlayerMap, tileMemorizationAcrossLevels) {
+    auto world = std::make_shared<core::World>();
+    world->tiles().assign({ 3, 3, 2 }, core::Tile::EMPTY);
+    world->player(makeTestActor());
+
+    render::PlayerMap playerMap{ world, nullptr };
+    playerMap.onGenerate();
+    playerMap.update();
+    world->player().position({ 0, 0, 1 });
+    playerMap.update();
+
+    for (int x = 0; x < 3; ++x)
+        for (int y = 0; y < 3; ++y) {
+            EXPECT_EQ(playerMap.tileState({ x, y, 0 }), render::PlayerMap::TileState::MEMORIZED);
+            EXPECT_EQ(playerMap.tileState({ x, y, 1 }), render::PlayerMap::TileState::VISIBLE);
+        }
+}
+
 TEST(PlayerMap, seenActors) {
     auto world = createWallWorld();
     world->player().position({ 1, 0, 0 });
@@ -123,7 +143,7 @@ TEST(PlayerMap, seenActors) {
     world->addActor(makeTestActor({ 2, 0, 0 }));
     world->addActor(makeTestActor({ 2, 2, 0 }));
 
-    render::PlayerMap playerMap{ world, nullptr, std::make_shared<util::Raycaster>(world) };
+    render::PlayerMap playerMap{ world, nullptr };
     playerMap.onGenerate();
     playerMap.update();
 
@@ -136,7 +156,7 @@ TEST(PlayerMap, seenActorsMemorization) {
     auto actor = makeTestActor({ 2, 0, 0 });
     world->addActor(actor);
 
-    render::PlayerMap playerMap{ world, nullptr, std::make_shared<util::Raycaster>(world) };
+    render::PlayerMap playerMap{ world, nullptr };
     playerMap.onGenerate();
 
     world->player().position({ 1, 0, 0 });
@@ -148,3 +168,58 @@ TEST(PlayerMap, seenActorsMemorization) {
     EXPECT_EQ(std::ssize(playerMap.seenActors()), 1);
     EXPECT_EQ(playerMap.seenActors()[0].position, (core::Position<int>{ 2, 0, 0 }));
 }
+
+TEST(PlayerMap, exploreRevealsAllTiles) {
+    auto world = std::make_shared<core::World>();
+    world->tiles().assign({ 9, 5, 1 }, core::Tile::EMPTY);
+    for (int x = 0; x < 8; ++x)
+        world->tiles()[{x, 2, 0}] = core::Tile::WALL;
+    world->player(makeTestActor({ 0, 0, 0 }));
+
+    render::PlayerMap playerMap{ world, nullptr };
+    playerMap.onGenerate();
+    playerMap.update();
+    EXPECT_EQ(playerMap.tileState({ 0, 4, 0 }), render::PlayerMap::TileState::UNSEEN);
+
+    int steps = 0;
+    while (auto step = playerMap.nextExploreStep(world->player().position())) {
+        ASSERT_LT(steps++, 100);
+        world->player().position(world->player().position() + *step);
+        playerMap.update();
+    }
+
+    for (int x = 0; x < 9; ++x)
+        for (int y = 0; y < 5; ++y)
+            if (world->tiles()[{x, y, 0}] != core::Tile::WALL) {
+                EXPECT_NE(playerMap.tileState({ x, y, 0 }), render::PlayerMap::TileState::UNSEEN);
+            }
+}
+
+TEST(PlayerMap, canSeeMatchesVisibleTiles) {
+    auto world = std::make_shared<core::World>();
+    world->tiles().assign({ 12, 10, 1 }, core::Tile::EMPTY);
+    std::mt19937 randomEngine{ 3 };
+    std::bernoulli_distribution isWall{ 0.25 };
+    for (int x = 0; x < 12; ++x)
+        for (int y = 0; y < 10; ++y)
+            if (isWall(randomEngine))
+                world->tiles()[{ x, y, 0 }] = core::Tile::WALL;
+    world->player(makeTestActor());
+
+    render::PlayerMap playerMap{ world, nullptr };
+    playerMap.onGenerate();
+    for (sf::Vector3i position : { sf::Vector3i{ 0, 0, 0 }, sf::Vector3i{ 5, 4, 0 }, sf::Vector3i{ 11, 9, 0 } }) {
+        world->tiles()[position] = core::Tile::EMPTY;
+        world->player().position(position);
+
+        std::vector<bool> canSee;
+        for (int x = 0; x < 12; ++x)
+            for (int y = 0; y < 10; ++y)
+                canSee.push_back(playerMap.canSee(core::Position<int>{ sf::Vector3i{ x, y, 0 } }));
+
+        playerMap.update();
+        for (int x = 0; x < 12; ++x)
+            for (int y = 0; y < 10; ++y)
+                EXPECT_EQ(canSee[x * 10 + y], playerMap.tileState({ x, y, 0 }) == render::PlayerMap::TileState::VISIBLE);
+    }
+}
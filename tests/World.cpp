@@ -139,6 +139,28 @@ TEST(World, actorAtNull) {
 	EXPECT_EQ(world.actorAt(core::Position<int>{ 2, 3, 11 }), nullptr);
 }
 
+TEST(World, actorAtDead) {
+	core::World world;
+	world.tiles().assign({ 3, 3, 1 }, core::Tile::EMPTY);
+
+	auto actor = makeTestActor({ 1, 1, 0 });
+	world.addActor(actor);
+	actor->beBanished();
+
+	EXPECT_EQ(world.actorAt(core::Position<int>{ 1, 1, 0 }), nullptr);
+}
+
+TEST(World, clearActors) {
+	core::World world;
+	world.tiles().assign({ 3, 3, 1 }, core::Tile::EMPTY);
+
+	world.addActor(makeTestActor({ 1, 1, 0 }));
+	world.clearActors();
+
+	EXPECT_TRUE(world.actors().empty());
+	EXPECT_EQ(world.actorAt(core::Position<int>{ 1, 1, 0 }), nullptr);
+}
+
 TEST(World, update) {
 	core::World world;
 	std::vector<int> log;
@@ -269,9 +291,226 @@ TEST(World, makeSound) {
 	actor2->controller(std::make_unique<TestController>(actor2));
 	world.addActor(actor2);
 
-	core::Sound sound{ core::Sound::Type::ATTACK, true, {1, 0, 1} };
+	core::Sound sound{ core::Sound::Type::ATTACK, true, {1, 0, 0} };
 	world.makeSound(sound);
 
 	EXPECT_EQ(dynamic_cast<TestController&>(actor1->controller()).lastSound(), sound);
 	EXPECT_EQ(dynamic_cast<TestController&>(actor2->controller()).lastSound(), sound);
 }
+
+TEST(World, makeSoundOtherLevel) {
+	core::World world;
+
+	auto actor = makeTestActor({ 0, 0, 0 });
+	actor->controller(std::make_unique<TestController>(actor));
+	world.addActor(actor);
+
+	core::Sound sound{ core::Sound::Type::ATTACK, true, {1, 0, 1} };
+	world.makeSound(sound);
+
+	EXPECT_EQ(dynamic_cast<TestController&>(actor->controller()).lastSound(), core::Sound{});
+}
+
+TEST(World, actorsOnLevel) {
+	auto actor1 = makeTestActor({ 0, 0, 0 });
+	auto actor2 = makeTestActor({ 2, 3, 1 });
+	auto actor3 = makeTestActor({ 4, 1, 1 });
+
+	core::World world;
+	world.addActor(actor1);
+	world.addActor(actor2);
+	world.addActor(actor3);
+
+	auto level = world.actorsOnLevel(1);
+	EXPECT_EQ(level.size(), 2);
+	EXPECT_EQ(std::ranges::count(level, actor2.get()), 1);
+	EXPECT_EQ(std::ranges::count(level, actor3.get()), 1);
+	EXPECT_TRUE(world.actorsOnLevel(2).empty());
+}
+
+TEST(World, actorsInRadius) {
+	auto world = std::make_shared<core::World>();
+	world->tiles().assign({ 20, 20, 2 }, core::Tile::EMPTY);
+
+	auto near = std::make_shared<core::Actor>(core::Actor::Stats{ .maxHp = 1 },
+		"test", sf::Vector3i{ 10, 12, 0 }, world, testXpManager, nullptr, nullptr);
+	auto far = std::make_shared<core::Actor>(core::Actor::Stats{ .maxHp = 1 },
+		"test", sf::Vector3i{ 17, 10, 0 }, world, testXpManager, nullptr, nullptr);
+	auto otherLevel = std::make_shared<core::Actor>(core::Actor::Stats{ .maxHp = 1 },
+		"test", sf::Vector3i{ 10, 10, 1 }, world, testXpManager, nullptr, nullptr);
+	world->addActor(near);
+	world->addActor(far);
+	world->addActor(otherLevel);
+
+	auto found = world->actorsInRadius({ 10, 10, 0 }, 3);
+	ASSERT_EQ(found.size(), 1);
+	EXPECT_EQ(found.front(), near.get());
+
+	far->position({ 12, 10, 0 });
+	EXPECT_EQ(world->actorsInRadius({ 10, 10, 0 }, 3).size(), 2);
+
+	near->position({ 10, 12, 1 });
+	EXPECT_EQ(world->actorsInRadius({ 10, 10, 0 }, 3).size(), 1);
+	EXPECT_EQ(world->actorsOnLevel(1).size(), 2);
+}
+
+TEST(World, reschedule) {
+	std::vector<int> log;
+	auto world = std::make_shared<core::World>();
+
+	auto actor1 = std::make_shared<core::Actor>(core::Actor::Stats{ .maxHp = 1, .turnDelay = 2 },
+		"test", sf::Vector3i{}, world, testXpManager, nullptr, nullptr);
+	actor1->controller(std::make_unique<TestController>(actor1, 0, &log, 0));
+	actor1->nextTurn(1);
+	world->addActor(actor1);
+
+	auto actor2 = std::make_shared<core::Actor>(core::Actor::Stats{ .maxHp = 1, .turnDelay = 2 },
+		"test", sf::Vector3i{}, world, testXpManager, nullptr, nullptr);
+	actor2->controller(std::make_unique<TestController>(actor2, 1, &log, 0));
+	actor2->nextTurn(2);
+	world->addActor(actor2);
+
+	actor2->nextTurn(0);
+	world->update();
+
+	ASSERT_EQ(log.size(), 1);
+	EXPECT_EQ(log.front(), 1);
+}
+
+TEST(World, removeDead) {
+	auto world = std::make_shared<core::World>();
+	auto xpManager = std::make_shared<core::XpManager>(world);
+
+	auto actor = std::make_shared<core::Actor>(core::Actor::Stats{ .maxHp = 1, .turnDelay = 1 },
+		"test", sf::Vector3i{}, world, xpManager, nullptr, nullptr);
+	actor->controller(std::make_unique<TestController>(actor, 0, nullptr, 0));
+	world->addActor(actor);
+	world->player(actor);
+
+	actor->beDamaged(std::numeric_limits<double>::infinity(), core::DamageType::PHYSICAL);
+	world->update();
+
+	EXPECT_TRUE(world->actors().empty());
+	EXPECT_TRUE(world->actorsOnLevel(0).empty());
+}
+
+TEST(World, randomFreePosition) {
+	util::RandomEngine randomEngine;
+	core::World world{ randomEngine };
+	world.tiles().assign({ 3, 3, 1 }, core::Tile::WALL);
+
+	world.tiles()[{ 0, 0, 0 }] = core::Tile::EMPTY;
+	world.tiles()[{ 1, 2, 0 }] = core::Tile::EMPTY;
+	world.tiles()[{ 2, 1, 0 }] = core::Tile::EMPTY;
+
+	world.addActor(makeTestActor({2, 1, 0}));
+
+	for (int i = 0; i < 100; ++i) {
+		auto position = world.randomFreePosition(0);
+		ASSERT_TRUE(position);
+		EXPECT_TRUE(*position == sf::Vector3i(0, 0, 0) || *position == sf::Vector3i(1, 2, 0));
+	}
+}
+
+TEST(World, randomFreePositionNone) {
+	util::RandomEngine randomEngine;
+	core::World world{ randomEngine };
+	world.tiles().assign({ 3, 3, 1 }, core::Tile::WALL);
+
+	EXPECT_FALSE(world.randomFreePosition(0));
+	EXPECT_FALSE(world.randomFreePosition(1));
+}
+
+TEST(World, randomFreePositionUpdate) {
+	util::RandomEngine randomEngine;
+	auto world = std::make_shared<core::World>(randomEngine);
+	world->tiles().assign({ 2, 1, 1 }, core::Tile::EMPTY);
+
+	auto actor = std::make_shared<core::Actor>(core::Actor::Stats{ .maxHp = 1 },
+		"test", sf::Vector3i{ 0, 0, 0 }, world, testXpManager, nullptr, nullptr);
+	world->addActor(actor);
+	EXPECT_EQ(world->randomFreePosition(0), sf::Vector3i(1, 0, 0));
+
+	actor->position({ 1, 0, 0 });
+	EXPECT_EQ(world->randomFreePosition(0), sf::Vector3i(0, 0, 0));
+
+	world->tile({ 0, 0, 0 }, core::Tile::WALL);
+	EXPECT_FALSE(world->randomFreePosition(0));
+
+	actor->beBanished();
+	EXPECT_EQ(world->randomFreePosition(0), sf::Vector3i(1, 0, 0));
+
+	world->tiles()[{ 0, 0, 0 }] = core::Tile::EMPTY;
+	world->tiles()[{ 1, 0, 0 }] = core::Tile::WALL;
+	world->tilesChanged();
+	EXPECT_EQ(world->randomFreePosition(0), sf::Vector3i(0, 0, 0));
+}
+
+TEST(World, stairsDestination) {
+	core::World world;
+	world.tiles().assign({ 2, 2, 2 }, core::Tile::EMPTY);
+	world.addStairs({ 0, 1, 0 }, { 1, 0, 1 });
+
+	EXPECT_EQ(world.stairsDestination({ 0, 1, 0 }), sf::Vector3i(1, 0, 1));
+	EXPECT_EQ(world.stairsDestination({ 1, 0, 1 }), sf::Vector3i(0, 1, 0));
+	EXPECT_FALSE(world.stairsDestination({ 0, 0, 0 }));
+	EXPECT_FALSE(world.stairsDestination({ 5, 5, 5 }));
+}
+
+TEST(World, stairsDestinationReplaced) {
+	core::World world;
+	world.tiles().assign({ 2, 2, 3 }, core::Tile::EMPTY);
+	world.addStairs({ 0, 1, 0 }, { 1, 0, 1 });
+	world.addStairs({ 1, 0, 2 }, { 0, 1, 0 });
+
+	EXPECT_EQ(world.stairsDestination({ 0, 1, 0 }), sf::Vector3i(1, 0, 2));
+}
+
+TEST(World, changeJournal) {
+	auto world = std::make_shared<core::World>();
+	world->tiles().assign({ 5, 5, 2 }, core::Tile::EMPTY);
+
+	auto actor = std::make_shared<core::Actor>(core::Actor::Stats{ .maxHp = 1 },
+		"test", sf::Vector3i{ 1, 1, 0 }, world, testXpManager, nullptr, nullptr);
+	world->addActor(actor);
+	actor->position({ 2, 3, 0 });
+	world->tile({ 4, 0, 1 }, core::Tile::WALL);
+
+	const auto& changes = world->changes();
+	ASSERT_EQ(changes.tiles().size(), 1);
+	EXPECT_EQ(changes.tiles()[0].position, sf::Vector3i(4, 0, 1));
+	EXPECT_EQ(changes.tiles()[0].oldTile, core::Tile::EMPTY);
+	EXPECT_EQ(changes.tiles()[0].newTile, core::Tile::WALL);
+
+	ASSERT_EQ(changes.actors().size(), 2);
+	EXPECT_EQ(changes.actors()[0].type, core::ChangeJournal::ActorChange::Type::SPAWNED);
+	EXPECT_EQ(changes.actors()[1].type, core::ChangeJournal::ActorChange::Type::MOVED);
+	EXPECT_EQ(changes.actors()[1].actor, actor->handle());
+	EXPECT_EQ(changes.actors()[1].oldPosition, sf::Vector3i(1, 1, 0));
+	EXPECT_EQ(changes.actors()[1].newPosition, sf::Vector3i(2, 3, 0));
+
+	EXPECT_EQ(changes.dirtyRect(0), sf::IntRect(1, 1, 2, 3));
+	EXPECT_EQ(changes.dirtyRect(1), sf::IntRect(4, 0, 1, 1));
+}
+
+TEST(World, publishChanges) {
+	core::World world;
+	world.tiles().assign({ 2, 2, 1 }, core::Tile::EMPTY);
+
+	int calls = 0;
+	bool tilesChanged = false;
+	world.addChangeListener([&](const core::ChangeJournal& changes) {
+		++calls;
+		tilesChanged = changes.tilesChanged();
+	});
+
+	world.publishChanges();
+	EXPECT_EQ(calls, 0);
+
+	world.tilesChanged();
+	EXPECT_EQ(world.changes().dirtyRect(0), sf::IntRect(0, 0, 2, 2));
+	world.publishChanges();
+	EXPECT_EQ(calls, 1);
+	EXPECT_TRUE(tilesChanged);
+	EXPECT_TRUE(world.changes().empty());
+}
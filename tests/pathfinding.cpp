@@ -16,9 +16,14 @@ If not, see <https://www.gnu.org/licenses/>. */
 #include "util/pathfinding.hpp"
 
 #include "core/World.hpp"
+#include "util/Array3D.hpp"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 /*
 TEST(pathfinding, nextStepInPlace) {
     core::World world;
@@ -62,4 +67,643 @@ TEST(pathfinding, nextStepUpStairs) {
 
     EXPECT_EQ(util::nextStep(world, { 0, 1, 1 }, { 1, 1, 0 }), (sf::Vector3i{ 1,  -1, -1 }));
 }
-*/
\ No newline at end of file
+*/
+
+TEST(pathfinding, pathBufferResetInvalidatesNodes) {
+    util::PathBuffer buffer;
+    buffer.reset({ 3, 3, 1 });
+    buffer[{1, 1, 0}].distance = 5;
+
+    buffer.reset({ 3, 3, 1 });
+    EXPECT_EQ((buffer[{1, 1, 0}].distance), util::PathBuffer::Node::unreached);
+}
+
+TEST(pathfinding, nextStepReusedBuffer) {
+    core::World world;
+    world.tiles().assign({ 5, 1, 1 }, core::Tile::EMPTY);
+
+    util::PathBuffer buffer;
+    util::CachedPath path1, path2;
+    EXPECT_EQ(util::nextStep(world, { 2, 0, 0 }, { 4, 0, 0 }, path1, buffer), (sf::Vector3i{ 1, 0, 0 }));
+    EXPECT_EQ(util::nextStep(world, { 2, 0, 0 }, { 0, 0, 0 }, path2, buffer), (sf::Vector3i{ -1, 0, 0 }));
+}
+
+TEST(pathfinding, nextStepCachedPath) {
+    core::World world;
+    world.tiles().assign({ 5, 1, 1 }, core::Tile::EMPTY);
+
+    util::Pathfinder pathfinder;
+    util::CachedPath path;
+    EXPECT_EQ(pathfinder.nextStep(world, { 0, 0, 0 }, { 4, 0, 0 }, path), (sf::Vector3i{ 1, 0, 0 }));
+    EXPECT_EQ(path.steps.size(), 5u);
+
+    EXPECT_EQ(pathfinder.nextStep(world, { 1, 0, 0 }, { 4, 0, 0 }, path), (sf::Vector3i{ 1, 0, 0 }));
+    EXPECT_EQ(path.steps.size(), 4u);
+
+    EXPECT_EQ(pathfinder.nextStep(world, { 4, 0, 0 }, { 4, 0, 0 }, path), (sf::Vector3i{ 0, 0, 0 }));
+    EXPECT_EQ(pathfinder.allocatedBuffers(), 1);
+}
+
+TEST(pathfinding, nextStepUnreachable) {
+    core::World world;
+    world.tiles().assign({ 3, 1, 1 }, core::Tile::EMPTY);
+    world.tiles()[{1, 0, 0}] = core::Tile::WALL;
+
+    util::Pathfinder pathfinder;
+    util::CachedPath path;
+    EXPECT_EQ(pathfinder.nextStep(world, { 0, 0, 0 }, { 2, 0, 0 }, path), (sf::Vector3i{ 0, 0, 0 }));
+}
+
+TEST(pathfinding, nextStepThroughStairs) {
+    core::World world;
+    world.tiles().assign({ 3, 1, 2 }, core::Tile::EMPTY);
+    world.tiles()[{1, 0, 0}] = core::Tile::WALL;
+    world.addStairs({ 0, 0, 0 }, { 0, 0, 1 });
+    world.addStairs({ 2, 0, 1 }, { 2, 0, 0 });
+
+    util::Pathfinder pathfinder;
+    util::CachedPath path;
+    EXPECT_EQ(pathfinder.nextStep(world, { 0, 0, 0 }, { 2, 0, 0 }, path), (sf::Vector3i{ 0, 0, 1 }));
+    EXPECT_EQ(path.steps.size(), 5u);
+}
+
+TEST(pathfinding, packedNodeSize) {
+    EXPECT_LE(sizeof(util::PathBuffer::Node), 6u);
+}
+
+namespace {
+    /// Checks that jump point search finds valid paths as short as breadth first search over moves and stairs
+    void expectJumpPointPathsShortest(const core::World& world, util::RandomEngine& randomEngine, int minReached) {
+        auto isPassable = [](const core::World& world, sf::Vector3i pos) {
+            return core::isPassable(world.tiles()[pos]);
+        };
+
+        sf::Vector3i shape = world.tiles().shape();
+        util::PathBuffer jpsBuffer;
+        util::DistanceField field;
+        int reached = 0;
+        std::uniform_int_distribution x{0, shape.x - 1};
+        std::uniform_int_distribution y{0, shape.y - 1};
+        std::uniform_int_distribution level{0, shape.z - 1};
+        for (int i = 0; i < 200; ++i) {
+            sf::Vector3i from{x(randomEngine), y(randomEngine), level(randomEngine)};
+            sf::Vector3i to{x(randomEngine), y(randomEngine), level(randomEngine)};
+            if (!isPassable(world, from) || !isPassable(world, to))
+                continue;
+
+            field.compute(world, {from});
+            util::findJumpPointPath(world, from, to, jpsBuffer, isPassable);
+            if (field.distance(to) == util::DistanceField::unreached) {
+                ASSERT_EQ(jpsBuffer[to].distance, util::PathBuffer::Node::unreached);
+                continue;
+            }
+            ASSERT_EQ(jpsBuffer[to].distance, field.distance(to));
+            ++reached;
+
+            util::CachedPath path;
+            util::tracePath(world, jpsBuffer, from, to, path);
+            ASSERT_EQ(std::ssize(path.steps), jpsBuffer[to].distance + 1);
+            for (ptrdiff_t j = 0; j + 1 < std::ssize(path.steps); ++j) {
+                ASSERT_TRUE(isPassable(world, path.steps[j]));
+                sf::Vector3i offset = path.steps[j] - path.steps[j + 1];
+                ASSERT_TRUE((util::uniformNorm(util::getXY(offset)) <= 1 && offset.z == 0)
+                         || world.stairsDestination(path.steps[j + 1]) == path.steps[j]);
+            }
+        }
+        EXPECT_GT(reached, minReached);
+    }
+}
+
+TEST(pathfinding, jumpPointSearchIsShortest) {
+    util::RandomEngine randomEngine{42};
+    core::World world;
+    world.tiles().assign({ 24, 24, 2 }, core::Tile::EMPTY);
+    for (int x = 0; x < 24; ++x)
+        for (int y = 0; y < 24; ++y)
+            for (int z = 0; z < 2; ++z)
+                if (std::bernoulli_distribution{0.3}(randomEngine))
+                    world.tiles()[{x, y, z}] = core::Tile::WALL;
+    world.tiles()[{3, 3, 0}] = core::Tile::EMPTY;
+    world.tiles()[{20, 20, 1}] = core::Tile::EMPTY;
+    world.addStairs({ 3, 3, 0 }, { 20, 20, 1 });
+
+    expectJumpPointPathsShortest(world, randomEngine, 50);
+}
+
+TEST(pathfinding, jumpPointSearchIsShortestInOpenRooms) {
+    util::RandomEngine randomEngine{5};
+    core::World world;
+    world.tiles().assign({ 20, 15, 3 }, core::Tile::EMPTY);
+    world.addStairs({ 2, 12, 0 }, { 17, 1, 1 });
+    world.addStairs({ 18, 13, 0 }, { 0, 0, 2 });
+    world.addStairs({ 9, 7, 1 }, { 19, 14, 2 });
+
+    expectJumpPointPathsShortest(world, randomEngine, 150);
+}
+
+TEST(pathfinding, distanceFieldMatchesAStar) {
+    util::RandomEngine randomEngine{7};
+    core::World world;
+    world.tiles().assign({ 16, 16, 2 }, core::Tile::EMPTY);
+    for (int x = 0; x < 16; ++x)
+        for (int y = 0; y < 16; ++y)
+            for (int z = 0; z < 2; ++z)
+                if (std::bernoulli_distribution{0.3}(randomEngine))
+                    world.tiles()[{x, y, z}] = core::Tile::WALL;
+    world.tiles()[{2, 2, 0}] = core::Tile::EMPTY;
+    world.tiles()[{13, 13, 1}] = core::Tile::EMPTY;
+    world.addStairs({ 2, 2, 0 }, { 13, 13, 1 });
+
+    auto isPassable = [](const core::World& world, sf::Vector3i pos) {
+        return core::isPassable(world.tiles()[pos]);
+    };
+
+    sf::Vector3i source{2, 2, 0};
+    util::DistanceField field;
+    field.compute(world, {source});
+
+    util::PathBuffer buffer;
+    for (int x = 0; x < 16; ++x)
+        for (int y = 0; y < 16; ++y)
+            for (int z = 0; z < 2; ++z) {
+                sf::Vector3i position{x, y, z};
+                if (!isPassable(world, position))
+                    continue;
+
+                util::findPath(world, position, source, buffer, isPassable);
+                ASSERT_EQ(field.distance(position), buffer[source].distance);
+            }
+}
+
+TEST(pathfinding, distanceFieldMultipleSources) {
+    core::World world;
+    world.tiles().assign({ 7, 1, 1 }, core::Tile::EMPTY);
+
+    util::DistanceField field;
+    field.compute(world, {{ 0, 0, 0 }, { 6, 0, 0 }});
+    EXPECT_EQ(field.distance({ 2, 0, 0 }), 2);
+    EXPECT_EQ(field.distance({ 5, 0, 0 }), 1);
+    EXPECT_EQ(field.nextStep(world, { 5, 0, 0 }), (sf::Vector3i{ 1, 0, 0 }));
+    EXPECT_EQ(field.nextStep(world, { 6, 0, 0 }), (sf::Vector3i{ 0, 0, 0 }));
+}
+
+TEST(pathfinding, nextFlowStepThroughStairs) {
+    core::World world;
+    world.tiles().assign({ 3, 1, 2 }, core::Tile::EMPTY);
+    world.tiles()[{1, 0, 0}] = core::Tile::WALL;
+    world.addStairs({ 0, 0, 0 }, { 0, 0, 1 });
+    world.addStairs({ 2, 0, 1 }, { 2, 0, 0 });
+
+    util::Pathfinder pathfinder;
+    EXPECT_EQ(pathfinder.nextFlowStep(world, { 0, 0, 0 }, { 2, 0, 0 }), (sf::Vector3i{ 0, 0, 1 }));
+    EXPECT_EQ(pathfinder.nextFlowStep(world, { 0, 0, 1 }, { 2, 0, 0 }), (sf::Vector3i{ 1, 0, 0 }));
+}
+
+TEST(pathfinding, nextFlowStepRecomputedOnlyIfTargetMoved) {
+    core::World world;
+    world.tiles().assign({ 5, 5, 1 }, core::Tile::EMPTY);
+
+    util::Pathfinder pathfinder;
+    EXPECT_EQ(pathfinder.nextFlowStep(world, { 0, 0, 0 }, { 4, 4, 0 }), (sf::Vector3i{ 1, 1, 0 }));
+    EXPECT_EQ(pathfinder.nextFlowStep(world, { 0, 4, 0 }, { 4, 4, 0 }), (sf::Vector3i{ 1, 0, 0 }));
+    EXPECT_EQ(pathfinder.flowFieldComputations(), 1);
+
+    EXPECT_EQ(pathfinder.nextFlowStep(world, { 0, 4, 0 }, { 0, 0, 0 }), (sf::Vector3i{ 0, -1, 0 }));
+    EXPECT_EQ(pathfinder.flowFieldComputations(), 2);
+
+    world.tiles()[{0, 3, 0}] = core::Tile::WALL;
+    pathfinder.clear();
+    EXPECT_EQ(pathfinder.nextFlowStep(world, { 0, 4, 0 }, { 0, 0, 0 }), (sf::Vector3i{ 1, -1, 0 }));
+    EXPECT_EQ(pathfinder.flowFieldComputations(), 3);
+}
+
+TEST(pathfinding, stairGraphChoosesNearestStairsToTarget) {
+    core::World world;
+    world.tiles().assign({ 7, 1, 2 }, core::Tile::EMPTY);
+    world.addStairs({ 0, 0, 0 }, { 0, 0, 1 });
+    world.addStairs({ 6, 0, 0 }, { 6, 0, 1 });
+
+    util::StairGraph graph;
+    EXPECT_EQ(graph.nextStairs(world, { 2, 0, 0 }, { 5, 0, 1 }), (sf::Vector3i{ 6, 0, 0 }));
+    EXPECT_EQ(graph.nextStairs(world, { 4, 0, 0 }, { 1, 0, 1 }), (sf::Vector3i{ 0, 0, 0 }));
+
+    world.tiles()[{3, 0, 1}] = core::Tile::WALL;
+    world.tiles()[{4, 0, 1}] = core::Tile::WALL;
+    graph.invalidate(1);
+    EXPECT_EQ(graph.nextStairs(world, { 4, 0, 0 }, { 2, 0, 1 }), (sf::Vector3i{ 0, 0, 0 }));
+
+    world.tiles()[{5, 0, 1}] = core::Tile::WALL;
+    world.tiles()[{1, 0, 1}] = core::Tile::WALL;
+    graph.invalidate(1);
+    EXPECT_EQ(graph.nextStairs(world, { 4, 0, 0 }, { 2, 0, 1 }), std::nullopt);
+}
+
+TEST(pathfinding, stairGraphSkipsUnusableStairs) {
+    core::World world;
+    world.tiles().assign({ 7, 1, 2 }, core::Tile::EMPTY);
+    world.addStairs({ 0, 0, 0 }, { 0, 0, 1 });
+    world.addStairs({ 6, 0, 0 }, { 6, 0, 1 });
+
+    util::StairGraph graph;
+    auto notFirstColumn = [](sf::Vector3i stairs) { return stairs.x != 0; };
+    EXPECT_EQ(graph.nextStairs(world, { 2, 0, 0 }, { 1, 0, 1 }, notFirstColumn), (sf::Vector3i{ 6, 0, 0 }));
+
+    auto notUpperLevel = [](sf::Vector3i stairs) { return stairs.z != 1; };
+    EXPECT_EQ(graph.nextStairs(world, { 2, 0, 0 }, { 1, 0, 1 }, notUpperLevel), std::nullopt);
+}
+
+TEST(pathfinding, nextStepAvoidsUnseenStairs) {
+    core::World world;
+    world.tiles().assign({ 7, 1, 2 }, core::Tile::EMPTY);
+    world.addStairs({ 0, 0, 0 }, { 0, 0, 1 });
+    world.addStairs({ 6, 0, 0 }, { 6, 0, 1 });
+
+    auto isSeen = [](const core::World& world, sf::Vector3i pos) {
+        return core::isPassable(world.tiles()[pos]) && pos != sf::Vector3i{ 0, 0, 1 };
+    };
+
+    util::Pathfinder pathfinder;
+    util::CachedPath path;
+    EXPECT_EQ(pathfinder.nextStep(world, { 2, 0, 0 }, { 2, 0, 1 }, path, isSeen), (sf::Vector3i{ 1, 0, 0 }));
+}
+
+TEST(pathfinding, stairGraphInvalidatesOnlyChangedLevel) {
+    core::World world;
+    world.tiles().assign({ 5, 1, 3 }, core::Tile::EMPTY);
+    world.addStairs({ 0, 0, 0 }, { 0, 0, 1 });
+    world.addStairs({ 4, 0, 1 }, { 4, 0, 2 });
+
+    util::Pathfinder pathfinder;
+    util::CachedPath path;
+    EXPECT_EQ(pathfinder.nextStep(world, { 2, 0, 0 }, { 2, 0, 2 }, path), (sf::Vector3i{ -1, 0, 0 }));
+
+    util::StairGraph graph;
+    graph.nextStairs(world, { 2, 0, 0 }, { 2, 0, 2 });
+    EXPECT_EQ(graph.levelComputations(), 3);
+
+    core::ChangeJournal changes;
+    changes.addTileChange({ 3, 0, 1 }, core::Tile::EMPTY, core::Tile::WALL);
+    world.tiles()[{3, 0, 1}] = core::Tile::WALL;
+    pathfinder.onChanges(changes);
+    graph.invalidate(1);
+
+    EXPECT_EQ(graph.nextStairs(world, { 2, 0, 0 }, { 2, 0, 2 }), std::nullopt);
+    EXPECT_EQ(graph.levelComputations(), 4);
+    util::CachedPath newPath;
+    EXPECT_EQ(pathfinder.nextStep(world, { 1, 0, 0 }, { 2, 0, 2 }, newPath), (sf::Vector3i{ 0, 0, 0 }));
+}
+
+TEST(pathfinding, crossLevelStepsFollowShortestPath) {
+    util::RandomEngine randomEngine{11};
+    core::World world;
+    world.tiles().assign({ 16, 16, 4 }, core::Tile::EMPTY);
+    for (int x = 0; x < 16; ++x)
+        for (int y = 0; y < 16; ++y)
+            for (int z = 0; z < 4; ++z)
+                if (std::bernoulli_distribution{0.25}(randomEngine))
+                    world.tiles()[{x, y, z}] = core::Tile::WALL;
+
+    std::uniform_int_distribution coordinate{0, 15};
+    for (int z = 0; z < 3; ++z)
+        for (int i = 0; i < 2; ++i) {
+            sf::Vector3i down{coordinate(randomEngine), coordinate(randomEngine), z};
+            sf::Vector3i up{coordinate(randomEngine), coordinate(randomEngine), z + 1};
+            if (world.stairsDestination(down) || world.stairsDestination(up))
+                continue;
+            world.tiles()[down] = core::Tile::EMPTY;
+            world.tiles()[up] = core::Tile::EMPTY;
+            world.addStairs(down, up);
+        }
+
+    auto isPassable = [](const core::World& world, sf::Vector3i pos) {
+        return core::isPassable(world.tiles()[pos]);
+    };
+
+    util::Pathfinder pathfinder;
+    util::DistanceField field;
+    int reached = 0;
+    std::uniform_int_distribution level{0, 3};
+    for (int i = 0; i < 100; ++i) {
+        sf::Vector3i from{coordinate(randomEngine), coordinate(randomEngine), level(randomEngine)};
+        sf::Vector3i to{coordinate(randomEngine), coordinate(randomEngine), level(randomEngine)};
+        if (!isPassable(world, from) || !isPassable(world, to) || from.z == to.z)
+            continue;
+
+        field.compute(world, {to});
+        int expected = field.distance(from);
+
+        util::CachedPath path;
+        sf::Vector3i position = from;
+        int steps = 0;
+        for (sf::Vector3i offset; (offset = pathfinder.nextStep(world, position, to, path)) != sf::Vector3i{}; ++steps) {
+            position += offset;
+            ASSERT_TRUE(isPassable(world, position));
+            ASSERT_LE(steps, 1000);
+        }
+
+        if (expected == util::DistanceField::unreached) {
+            EXPECT_EQ(position, from);
+            continue;
+        }
+        ++reached;
+        EXPECT_EQ(position, to);
+        EXPECT_EQ(steps, expected);
+    }
+    EXPECT_GT(reached, 10);
+}
+
+TEST(pathfinding, nextStepAvoidsStairsClosedByPredicate) {
+    core::World world;
+    world.tiles().assign({ 7, 3, 2 }, core::Tile::EMPTY);
+    world.addStairs({ 0, 1, 0 }, { 0, 1, 1 });
+    world.addStairs({ 6, 1, 0 }, { 6, 1, 1 });
+
+    std::vector<int> closedColumns{ 1 };
+    auto isPassable = [&closedColumns](const core::World& world, sf::Vector3i pos) {
+        return core::isPassable(world.tiles()[pos]) && (pos.z != 0 || !std::ranges::count(closedColumns, pos.x));
+    };
+
+    util::Pathfinder pathfinder;
+    util::CachedPath path;
+    sf::Vector3i position{ 2, 1, 0 };
+    int steps = 0;
+    for (sf::Vector3i offset; (offset = pathfinder.nextStep(world, position, { 0, 1, 1 }, path, isPassable)) != sf::Vector3i{}; ++steps) {
+        position += offset;
+        ASSERT_LE(steps, 100);
+    }
+    EXPECT_EQ(position, (sf::Vector3i{ 0, 1, 1 }));
+    EXPECT_EQ(steps, 11);
+
+    closedColumns.push_back(5);
+    path = {};
+    EXPECT_EQ(pathfinder.nextStep(world, { 2, 1, 0 }, { 0, 1, 1 }, path, isPassable), (sf::Vector3i{ 0, 0, 0 }));
+}
+
+TEST(pathfinding, crossLevelStepsWithPassabilityPredicate) {
+    util::RandomEngine randomEngine{17};
+    core::World world;
+    world.tiles().assign({ 16, 16, 3 }, core::Tile::EMPTY);
+    for (int x = 0; x < 16; ++x)
+        for (int y = 0; y < 16; ++y)
+            for (int z = 0; z < 3; ++z)
+                if (std::bernoulli_distribution{0.2}(randomEngine))
+                    world.tiles()[{x, y, z}] = core::Tile::WALL;
+
+    std::uniform_int_distribution coordinate{0, 15};
+    for (int z = 0; z < 2; ++z)
+        for (int i = 0; i < 3; ++i) {
+            sf::Vector3i down{coordinate(randomEngine), coordinate(randomEngine), z};
+            sf::Vector3i up{coordinate(randomEngine), coordinate(randomEngine), z + 1};
+            if (world.stairsDestination(down) || world.stairsDestination(up))
+                continue;
+            world.tiles()[down] = core::Tile::EMPTY;
+            world.tiles()[up] = core::Tile::EMPTY;
+            world.addStairs(down, up);
+        }
+
+    // Like tiles seen by the player: some passable tiles are forbidden, stairs shortest without predicate may be closed
+    util::Array3D<char> seen;
+    seen.assign(world.tiles().shape(), false);
+    for (int x = 0; x < 16; ++x)
+        for (int y = 0; y < 16; ++y)
+            for (int z = 0; z < 3; ++z)
+                seen[{x, y, z}] = std::bernoulli_distribution{0.8}(randomEngine);
+    auto isPassable = [&seen](const core::World& world, sf::Vector3i pos) {
+        return core::isPassable(world.tiles()[pos]) && seen[pos];
+    };
+
+    util::Pathfinder pathfinder;
+    util::PathBuffer buffer;
+    int reached = 0;
+    std::uniform_int_distribution level{0, 2};
+    for (int i = 0; i < 150; ++i) {
+        sf::Vector3i from{coordinate(randomEngine), coordinate(randomEngine), level(randomEngine)};
+        sf::Vector3i to{coordinate(randomEngine), coordinate(randomEngine), level(randomEngine)};
+        if (!isPassable(world, from) || !isPassable(world, to) || from.z == to.z)
+            continue;
+
+        util::findPath(world, from, to, buffer, isPassable);
+        int expected = buffer[to].distance;
+
+        util::CachedPath path;
+        sf::Vector3i position = from;
+        int steps = 0;
+        for (sf::Vector3i offset; (offset = pathfinder.nextStep(world, position, to, path, isPassable)) != sf::Vector3i{}; ++steps) {
+            sf::Vector3i previous = std::exchange(position, position + offset);
+            ASSERT_TRUE(isPassable(world, position) || world.stairsDestination(previous) == position);
+            ASSERT_LE(steps, 1000);
+        }
+
+        if (expected == util::PathBuffer::Node::unreached) {
+            EXPECT_NE(position, to);
+            continue;
+        }
+        ++reached;
+        EXPECT_EQ(position, to);
+        EXPECT_GE(steps, expected);
+    }
+    EXPECT_GT(reached, 10);
+}
+
+TEST(pathfinding, connectivityThroughStairs) {
+    core::World world;
+    world.tiles().assign({ 3, 1, 2 }, core::Tile::EMPTY);
+    world.tiles()[{1, 0, 0}] = core::Tile::WALL;
+
+    util::Connectivity connectivity;
+    EXPECT_FALSE(connectivity.connected(world, { 0, 0, 0 }, { 2, 0, 0 }));
+    EXPECT_FALSE(connectivity.connected(world, { 0, 0, 0 }, { 0, 0, 1 }));
+
+    world.addStairs({ 0, 0, 0 }, { 0, 0, 1 });
+    world.addStairs({ 2, 0, 1 }, { 2, 0, 0 });
+    connectivity.clear();
+    EXPECT_TRUE(connectivity.connected(world, { 0, 0, 0 }, { 2, 0, 0 }));
+    EXPECT_FALSE(connectivity.connected(world, { 0, 0, 0 }, { 1, 0, 0 }));
+}
+
+TEST(pathfinding, connectivityMergesDugTiles) {
+    core::World world;
+    world.tiles().assign({ 5, 1, 1 }, core::Tile::EMPTY);
+    world.tiles()[{2, 0, 0}] = core::Tile::WALL;
+
+    util::Connectivity connectivity;
+    EXPECT_FALSE(connectivity.connected(world, { 0, 0, 0 }, { 4, 0, 0 }));
+
+    core::ChangeJournal changes;
+    changes.addTileChange({ 2, 0, 0 }, core::Tile::WALL, core::Tile::EMPTY);
+    world.tiles()[{2, 0, 0}] = core::Tile::EMPTY;
+    connectivity.onChanges(changes);
+    EXPECT_TRUE(connectivity.connected(world, { 0, 0, 0 }, { 4, 0, 0 }));
+    EXPECT_EQ(connectivity.rebuilds(), 1);
+
+    changes.clear();
+    changes.addTileChange({ 2, 0, 0 }, core::Tile::EMPTY, core::Tile::WALL);
+    world.tiles()[{2, 0, 0}] = core::Tile::WALL;
+    connectivity.onChanges(changes);
+    EXPECT_FALSE(connectivity.connected(world, { 0, 0, 0 }, { 4, 0, 0 }));
+    EXPECT_EQ(connectivity.rebuilds(), 2);
+}
+
+TEST(pathfinding, nextStepRejectsOtherComponent) {
+    core::World world;
+    world.tiles().assign({ 9, 9, 1 }, core::Tile::EMPTY);
+    for (int i = 0; i < 9; ++i)
+        world.tiles()[{4, i, 0}] = core::Tile::WALL;
+
+    util::Pathfinder pathfinder;
+    util::CachedPath path;
+    EXPECT_EQ(pathfinder.nextStep(world, { 0, 0, 0 }, { 8, 8, 0 }, path), (sf::Vector3i{ 0, 0, 0 }));
+    EXPECT_EQ(pathfinder.allocatedBuffers(), 0);
+}
+
+TEST(pathfinding, nextStepRetargetsOntoPath) {
+    core::World world;
+    world.tiles().assign({ 7, 1, 1 }, core::Tile::EMPTY);
+
+    util::PathBuffer buffer;
+    util::CachedPath path;
+    EXPECT_EQ(util::nextStep(world, { 0, 0, 0 }, { 5, 0, 0 }, path, buffer), (sf::Vector3i{ 1, 0, 0 }));
+    auto stamp = buffer.currentStamp;
+
+    EXPECT_EQ(util::nextStep(world, { 0, 0, 0 }, { 3, 0, 0 }, path, buffer), (sf::Vector3i{ 1, 0, 0 }));
+    EXPECT_EQ(path.steps.front(), (sf::Vector3i{ 3, 0, 0 }));
+    EXPECT_EQ(buffer.currentStamp, stamp);
+}
+
+TEST(pathfinding, nextStepExtendsPathToMovedTarget) {
+    core::World world;
+    world.tiles().assign({ 9, 1, 1 }, core::Tile::EMPTY);
+
+    util::PathBuffer buffer;
+    util::CachedPath path;
+    util::nextStep(world, { 0, 0, 0 }, { 4, 0, 0 }, path, buffer);
+    auto stamp = buffer.currentStamp;
+
+    for (int target = 5; target < 5 + util::CachedPath::maxExtensions; ++target) {
+        EXPECT_EQ(util::nextStep(world, { 0, 0, 0 }, { target, 0, 0 }, path, buffer), (sf::Vector3i{ 1, 0, 0 }));
+        EXPECT_EQ(std::ssize(path.steps), target + 1);
+        EXPECT_EQ(buffer.currentStamp, stamp);
+    }
+
+    util::nextStep(world, { 0, 0, 0 }, { 5 + util::CachedPath::maxExtensions, 0, 0 }, path, buffer);
+    EXPECT_NE(buffer.currentStamp, stamp);
+    EXPECT_EQ(path.extensions, 0);
+}
+
+TEST(pathfinding, nextStepAvoidsTileClosedOnPath) {
+    core::World world;
+    world.tiles().assign({ 3, 3, 1 }, core::Tile::EMPTY);
+
+    util::Pathfinder pathfinder;
+    util::CachedPath path;
+    EXPECT_EQ(pathfinder.nextStep(world, { 0, 1, 0 }, { 2, 1, 0 }, path), (sf::Vector3i{ 1, 0, 0 }));
+
+    core::ChangeJournal changes;
+    changes.addTileChange({ 1, 1, 0 }, core::Tile::EMPTY, core::Tile::WALL);
+    world.tiles()[{1, 1, 0}] = core::Tile::WALL;
+    pathfinder.onChanges(changes);
+
+    sf::Vector3i step = pathfinder.nextStep(world, { 0, 1, 0 }, { 2, 1, 0 }, path);
+    EXPECT_EQ(step.x, 1);
+    EXPECT_NE(step.y, 0);
+}
+
+TEST(pathfinding, nextStepRepairsPathAroundClosedTile) {
+    core::World world;
+    world.tiles().assign({ 9, 3, 1 }, core::Tile::EMPTY);
+
+    util::Pathfinder pathfinder;
+    util::CachedPath path;
+    sf::Vector3i position{ 0, 1, 0 };
+    for (int i = 0; i < 2; ++i)
+        position += pathfinder.nextStep(world, position, { 8, 1, 0 }, path);
+
+    core::ChangeJournal changes;
+    changes.addTileChange({ 5, 1, 0 }, core::Tile::EMPTY, core::Tile::WALL);
+    world.tiles()[{5, 1, 0}] = core::Tile::WALL;
+    pathfinder.onChanges(changes);
+
+    int steps = 0;
+    for (sf::Vector3i offset; (offset = pathfinder.nextStep(world, position, { 8, 1, 0 }, path)) != sf::Vector3i{}; ++steps) {
+        EXPECT_EQ(path.extensions, 1);
+        position += offset;
+        ASSERT_TRUE(core::isPassable(world.tiles()[position]));
+        ASSERT_LE(steps, 100);
+    }
+    EXPECT_EQ(position, (sf::Vector3i{ 8, 1, 0 }));
+    EXPECT_LE(steps, 6 + 2);
+}
+
+TEST(pathfinding, nextStepRecomputesClosedPathIfTilesOpened) {
+    core::World world;
+    world.tiles().assign({ 9, 3, 1 }, core::Tile::EMPTY);
+    world.tiles()[{4, 0, 0}] = core::Tile::WALL;
+
+    util::Pathfinder pathfinder;
+    util::CachedPath path;
+    pathfinder.nextStep(world, { 0, 1, 0 }, { 8, 1, 0 }, path);
+
+    core::ChangeJournal changes;
+    changes.addTileChange({ 5, 1, 0 }, core::Tile::EMPTY, core::Tile::WALL);
+    changes.addTileChange({ 4, 0, 0 }, core::Tile::WALL, core::Tile::EMPTY);
+    world.tiles()[{5, 1, 0}] = core::Tile::WALL;
+    world.tiles()[{4, 0, 0}] = core::Tile::EMPTY;
+    pathfinder.onChanges(changes);
+
+    pathfinder.nextStep(world, { 0, 1, 0 }, { 8, 1, 0 }, path);
+    EXPECT_EQ(path.extensions, 0);
+    EXPECT_EQ(std::ssize(path.steps), 9);
+}
+
+TEST(pathfinding, nextStepDropsUnreachableMarkAfterDig) {
+    core::World world;
+    world.tiles().assign({ 3, 1, 1 }, core::Tile::EMPTY);
+    world.tiles()[{1, 0, 0}] = core::Tile::WALL;
+
+    util::Pathfinder pathfinder;
+    util::CachedPath path;
+    EXPECT_EQ(pathfinder.nextStep(world, { 0, 0, 0 }, { 2, 0, 0 }, path), (sf::Vector3i{ 0, 0, 0 }));
+
+    core::ChangeJournal changes;
+    changes.addTileChange({ 1, 0, 0 }, core::Tile::WALL, core::Tile::EMPTY);
+    world.tiles()[{1, 0, 0}] = core::Tile::EMPTY;
+    pathfinder.onChanges(changes);
+
+    EXPECT_EQ(pathfinder.nextStep(world, { 0, 0, 0 }, { 2, 0, 0 }, path), (sf::Vector3i{ 1, 0, 0 }));
+}
+
+TEST(pathfinding, distanceFieldRemoveSourcesMatchesRecompute) {
+    util::RandomEngine randomEngine{5};
+    core::World world;
+    world.tiles().assign({ 20, 20, 2 }, core::Tile::EMPTY);
+    for (int x = 0; x < 20; ++x)
+        for (int y = 0; y < 20; ++y)
+            for (int z = 0; z < 2; ++z)
+                if (std::bernoulli_distribution{0.3}(randomEngine))
+                    world.tiles()[{x, y, z}] = core::Tile::WALL;
+    world.tiles()[{1, 1, 0}] = core::Tile::EMPTY;
+    world.tiles()[{18, 18, 1}] = core::Tile::EMPTY;
+    world.addStairs({ 1, 1, 0 }, { 18, 18, 1 });
+
+    std::vector<sf::Vector3i> sources;
+    for (int x = 0; x < 20; ++x)
+        for (int y = 0; y < 20; ++y)
+            for (int z = 0; z < 2; ++z)
+                if (core::isPassable(world.tiles()[{x, y, z}]) && std::bernoulli_distribution{0.2}(randomEngine))
+                    sources.push_back({x, y, z});
+
+    util::DistanceField incremental, full;
+    incremental.compute(world, sources);
+    while (!sources.empty()) {
+        auto removedCount = std::min<ptrdiff_t>(std::ssize(sources), 7);
+        std::vector<sf::Vector3i> removed(sources.end() - removedCount, sources.end());
+        sources.resize(sources.size() - removedCount);
+
+        incremental.removeSources(world, removed);
+        full.compute(world, sources);
+        for (int x = 0; x < 20; ++x)
+            for (int y = 0; y < 20; ++y)
+                for (int z = 0; z < 2; ++z)
+                    ASSERT_EQ(incremental.distance({x, y, z}), full.distance({x, y, z}));
+    }
+}
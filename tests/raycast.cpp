@@ -19,6 +19,8 @@ If not, see <https://www.gnu.org/licenses/>. */
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 TEST(raycast, canSeeEmpty) {
     auto world = std::make_shared<core::World>();
     world->tiles().assign({ 3, 3, 1 }, core::Tile::EMPTY);
@@ -98,3 +100,100 @@ TEST(raycast, canSeeWallStiffAngle) {
     util::Raycaster raycaster{ std::move(world) };
     EXPECT_TRUE(raycaster.canSee({ 0, 4, 0 }, { 1, 0, 0 }));
 }
+
+TEST(raycast, cacheStats) {
+    auto world = std::make_shared<core::World>();
+    world->tiles().assign({ 3, 3, 1 }, core::Tile::EMPTY);
+
+    util::Raycaster raycaster{ std::move(world) };
+    EXPECT_TRUE(raycaster.canSee({ 0, 2, 0 }, { 2, 1, 0 }));
+    EXPECT_TRUE(raycaster.canSee({ 0, 2, 0 }, { 2, 1, 0 }));
+    EXPECT_EQ(raycaster.cacheMisses(), 1);
+    EXPECT_EQ(raycaster.cacheHits(), 1);
+    EXPECT_EQ(raycaster.cacheEvictions(), 0);
+}
+
+TEST(raycast, rowPerOrigin) {
+    auto world = std::make_shared<core::World>();
+    world->tiles().assign({ 3, 3, 2 }, core::Tile::EMPTY);
+    for (int x = 0; x < 3; ++x)
+        world->tiles()[{ x, 1, 1 }] = core::Tile::WALL;
+
+    util::Raycaster raycaster{ std::move(world) };
+    EXPECT_TRUE(raycaster.canSee({ 0, 0, 0 }, { 2, 2, 0 }));
+    EXPECT_TRUE(raycaster.canSee({ 0, 0, 0 }, { 2, 0, 0 }));
+    EXPECT_FALSE(raycaster.canSee({ 0, 0, 1 }, { 0, 2, 1 }));
+    EXPECT_TRUE(raycaster.canSee({ 0, 0, 0 }, { 2, 2, 0 }));
+    EXPECT_FALSE(raycaster.canSee({ 0, 0, 1 }, { 0, 2, 1 }));
+    EXPECT_EQ(raycaster.cacheMisses(), 3);
+    EXPECT_EQ(raycaster.cacheHits(), 2);
+}
+
+namespace {
+    std::shared_ptr<core::World> randomWorld() {
+        auto world = std::make_shared<core::World>();
+        world->tiles().assign({ 13, 9, 2 }, core::Tile::EMPTY);
+
+        std::mt19937 randomEngine{ 42 };
+        std::bernoulli_distribution isWall{ 0.3 };
+        for (int z = 0; z < 2; ++z)
+            for (int y = 0; y < 9; ++y)
+                for (int x = 0; x < 13; ++x)
+                    if (isWall(randomEngine))
+                        world->tiles()[{ x, y, z }] = core::Tile::WALL;
+        return world;
+    }
+
+    void expectSameAsReference(util::Raycaster& raycaster, const core::World& world) {
+        sf::Vector3i shape = world.tiles().shape();
+        for (int z = 0; z < shape.z; ++z)
+            for (int y1 = 0; y1 < shape.y; ++y1)
+                for (int x1 = 0; x1 < shape.x; ++x1)
+                    for (int y2 = 0; y2 < shape.y; ++y2)
+                        for (int x2 = 0; x2 < shape.x; ++x2)
+                            ASSERT_EQ(raycaster.canSee({ x1, y1, z }, { x2, y2, z }),
+                                      util::castRays(world, { x1, y1, z }, { x2, y2, z }))
+                                << x1 << ' ' << y1 << ' ' << x2 << ' ' << y2 << ' ' << z;
+    }
+}
+
+TEST(raycast, sameAsReference) {
+    auto world = randomWorld();
+    util::Raycaster raycaster{ world };
+    expectSameAsReference(raycaster, *world);
+}
+
+TEST(raycast, localInvalidation) {
+    auto world = randomWorld();
+    auto raycaster = std::make_shared<util::Raycaster>(world);
+    world->addChangeListener([raycaster](const core::ChangeJournal& changes) {
+        raycaster->onChanges(changes);
+    });
+    expectSameAsReference(*raycaster, *world);
+
+    world->tile({ 6, 4, 0 }, world->tiles()[{ 6, 4, 0 }] == core::Tile::WALL ? core::Tile::EMPTY : core::Tile::WALL);
+    world->tile({ 0, 0, 1 }, core::Tile::WALL);
+    world->publishChanges();
+
+    ptrdiff_t oldHits = raycaster->cacheHits();
+    ptrdiff_t oldMisses = raycaster->cacheMisses();
+    expectSameAsReference(*raycaster, *world);
+    EXPECT_GT(raycaster->cacheHits(), oldHits);
+    EXPECT_GT(raycaster->cacheMisses(), oldMisses);
+}
+
+TEST(raycast, repeatedChangesAreIdempotent) {
+    auto world = randomWorld();
+    util::Raycaster raycaster{ world };
+    expectSameAsReference(raycaster, *world);
+
+    core::Tile oldTile = world->tiles()[{ 6, 4, 0 }];
+    core::Tile newTile = oldTile == core::Tile::WALL ? core::Tile::EMPTY : core::Tile::WALL;
+    world->tiles()[{ 6, 4, 0 }] = newTile;
+
+    core::ChangeJournal changes;
+    changes.addTileChange({ 6, 4, 0 }, oldTile, newTile);
+    raycaster.onChanges(changes);
+    raycaster.onChanges(changes);
+    expectSameAsReference(raycaster, *world);
+}